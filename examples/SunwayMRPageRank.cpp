@@ -49,9 +49,8 @@ Pair< K, V > map_to_pair_do_nothing_f(Pair< K, V > &p) {
  * for each start of link, set rank as 1.0.
  * this is the initialization of all ranks.
  */
-Pair<string, double> map_values_f1(Pair<string, VectorIteratorSeq<string> > &p) {
-	double r = 1.0;
-	return Pair<string, double> (p.v1, r);
+double map_values_f1(VectorIteratorSeq<string> &links) {
+	return 1.0;
 }
 
 /*
@@ -82,9 +81,8 @@ Pair<string, double> reduce_by_key_f (Pair<string, double> &p1, Pair<string, dou
 /*
  * scale
  */
-Pair<string, double> map_values_f2(Pair<string, double> &p) {
-	double right = 0.15 + 0.85 * p.v2;
-	return Pair<string, double> (p.v1, right);
+double map_values_f2(double &rank) {
+	return 0.15 + 0.85 * rank;
 }
 
 /*
@@ -109,8 +107,7 @@ int main(int argc, char *argv[]) {
 	links->setSticky(true); // set this RDD as sticky, will not be deleted automatically
 
 	PairRDD<string, double, Pair<string, double > > *ranks =
-			links->mapValues(map_values_f1)
-					->mapToPair(map_to_pair_do_nothing_f<string, double>);
+			links->mapValues(map_values_f1);
 
 	for (int i=0; i<iteration; i++) { // iterations of page ranking
 		ranks =
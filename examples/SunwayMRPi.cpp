@@ -12,26 +12,26 @@
 using std::cout;
 using std::endl;
 
-unsigned int seed = time(NULL);
+uint64_t seed = time(NULL); // a new estimate on every run
 
 /*
- * generate a random number between start and end
+ * count points inside the circle of a partition.
+ * each partition has its own random generator,
+ * so task threads share no random state.
  */
-double random(double start, double end)
+void count_f(int index, IteratorSeq<long> &seq, vector<long> &output)
 {
-	return start+(end-start)*rand_r(&seed)/(RAND_MAX + 1.0);
-}
-
-/*
- * map function for every generated double number
- */
-long map_f(long &i)
-{
-	double x = random(-1, 1);
-	double y = random(-1, 1);
-	if(x*x + y*y <= 1)
-		return 1L;
-	return 0L;
+	XoshiroRandom random(seed, index);
+	long count = 0;
+	size_t n = seq.size();
+	for(size_t i = 0; i < n; i++)
+	{
+		double x = random.nextDouble() * 2 - 1;
+		double y = random.nextDouble() * 2 - 1;
+		if(x*x + y*y <= 1)
+			count++;
+	}
+	output.push_back(count);
 }
 
 /*
@@ -49,12 +49,10 @@ int main(int argc, char *argv[]) {
 	string start = currentDateTime(); // logging start time of computation
 	cout<< "SunwayMR Pi Calculation" << endl;
 
-	srand(unsigned(time(0)));
-
 	SunwayMRContext sc("SunwayMRPi", argc, argv);
 
 	long times = 100000000l;
-	int num = sc.parallelize(1l, times)->map(map_f)->reduce(reduce_f);
+	long num = sc.parallelize(1l, times)->mapPartitionsWithIndex(count_f)->reduce(reduce_f);
 	double ret = (4.0 * num / times);
 	cout << "Pi: " << ret << endl;
 
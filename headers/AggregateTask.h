@@ -0,0 +1,45 @@
+/*
+ * AggregateTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_AGGREGATETASK_H_
+#define HEADERS_AGGREGATETASK_H_
+
+#include <vector>
+#include <string>
+
+#include "RDDTask.h"
+using std::vector;
+using std::string;
+
+/*
+ * RDD::aggregate, RDD::fold and RDD::treeAggregate create and run AggregateTasks.
+ * Values of each partition are folded into a copy of the zero value by seqOp,
+ * results of partitions in the task are merged by combOp,
+ * and only the merged result is sent back.
+ * U must be convertible by to_string and from_string.
+ */
+template <class T, class U>
+class AggregateTask : public RDDTask<T, U> {
+public:
+	AggregateTask(RDD<T> *r, Partition *p, U &zero,
+			U (*seqOp)(U&, T&), U (*combOp)(U&, U&));
+	AggregateTask(RDD<T> *r, vector<Partition*> &group, U &zero,
+			U (*seqOp)(U&, T&), U (*combOp)(U&, U&)); // partitions preferring the same host
+	U run();
+	string serialize(U &t);
+	U deserialize(string &s);
+	vector<string> preferredLocations();
+	void scheduled(string host);
+
+private:
+	vector<Partition*> group;
+	U zero;
+	U (*seqOp)(U&, T&);
+	U (*combOp)(U&, U&);
+};
+
+
+#endif /* HEADERS_AGGREGATETASK_H_ */
@@ -0,0 +1,71 @@
+/*
+ * BaseShuffledRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_BASESHUFFLEDRDD_H_
+#define HEADERS_BASESHUFFLEDRDD_H_
+
+#include "Messaging.h"
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+#include "SunwayMRContext.h"
+#include "HashDivider.h"
+#include "ShuffledPartition.h"
+#include "ShuffledTask.h"
+#include "MapStatus.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <pthread.h>
+using namespace std;
+
+int XYZ_SHUFFLE_TASK_RETRIES = 1; // times a map task losing its output runs again, before the application stops
+
+/*
+ * Super class of RDDs built from the output of a shuffle: ShuffledRDD, GroupedRDD and SortedRDD.
+ * Map tasks of type ShuffledTask< Pair<K, V>, U > run on partitions of the previous RDD,
+ * then a new partition of values of type T is built from their output once, and cached.
+ * Sub-classes create the map tasks in constructors, and build partitions in iteratorSeq.
+ */
+template <class K, class V, class U, class T>
+class BaseShuffledRDD : public RDD<T>, public Messaging
+{
+public:
+	BaseShuffledRDD(RDD< Pair<K, V> > *_prevRDD, const HashDivider &_hd, string _name);
+	virtual ~BaseShuffledRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	size_t inputBytes(Partition *p);
+	void shuffle();
+	void setAdaptive(bool a);
+	void messageReceived(int localListenPort, string fromHost, int msgType, string &msg);
+
+protected:
+	RDD< Pair<K, V> > *prevRDD;
+	HashDivider hd;
+	string name; // class name, in logs
+	long shuffleID;
+	bool shuffleFinished;
+	vector< ShuffledTask< Pair<K, V>, U > * > shuffledTasks;
+	std::map<int, IteratorSeq<T>* > shuffleCache; // cache for iteratorSeq()
+	vector<pthread_mutex_t> shuffleMutexes; // one for each partition ID
+	vector<MapStatus> mapStatuses; // results of shuffle tasks
+	bool adaptive; // to coalesce small and split large partitions after the map stage
+	vector<Partition*> hashPartitions; // partitions before coalescing or splitting
+
+	virtual void beforeMapStage(bool toFile); // map tasks are cached, but not run yet
+	virtual void afterMapStage(); // map statuses are known
+	void retryFailedTasks(); // map tasks whose output was lost run again
+	IteratorSeq<T> * lockPartition(ShuffledPartition *srp); // cached data, or NULL with its mutex held
+	void unlockPartition(ShuffledPartition *srp, IteratorSeq<T> *seq); // cache data and release its mutex
+	void coalescePartitions();
+	void replacePartitions(vector<Partition*> &parts); // partitions after the map stage
+};
+
+
+#endif /* HEADERS_BASESHUFFLEDRDD_H_ */
@@ -0,0 +1,50 @@
+/*
+ * BroadcastJoinRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_BROADCASTJOINRDD_H_
+#define HEADERS_BROADCASTJOINRDD_H_
+
+#include <vector>
+#include <string>
+#include <tr1/unordered_map>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+using std::vector;
+using std::string;
+using std::tr1::unordered_map;
+
+template <class T> class RDD;
+
+/*
+ * BroadcastJoinRDD joins a large RDD< Pair<K, V> > with a small RDD< Pair<K, W> >.
+ * The small RDD is collected once, so every node holds it in a hash table,
+ * then partitions of the large RDD are probed against the table without shuffle.
+ * PairRDD::broadcastJoin will generate BroadcastJoinRDD.
+ */
+template <class K, class V, class W>
+class BroadcastJoinRDD : public RDD< Pair< K, Pair<V, W> > > {
+public:
+	BroadcastJoinRDD(RDD< Pair<K, V> > *prev, RDD< Pair<K, W> > *small);
+	~BroadcastJoinRDD();
+	vector<Partition *> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	IteratorSeq< Pair< K, Pair<V, W> > > * iteratorSeq(Partition *p);
+	void shuffle();
+	HashDivider * getPartitioner();
+
+private:
+	RDD< Pair<K, V> > *prevRDD;
+	RDD< Pair<K, W> > *smallRDD; // NULL after broadcast
+	unordered_map< K, vector<W> > table; // values of the small RDD by key
+	bool broadcastFinished;
+};
+
+
+#endif /* HEADERS_BROADCASTJOINRDD_H_ */
@@ -0,0 +1,105 @@
+/*
+ * CacheManager.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_CACHEMANAGER_H_
+#define HEADERS_CACHEMANAGER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <pthread.h>
+#include <time.h>
+
+#include "DataCache.h"
+using std::string;
+using std::vector;
+using std::map;
+
+long XYZ_CACHE_MEMORY_BUDGET = 1L << 30; // bytes of file contents kept in memory
+
+/*
+ * content of a file served by FILE_BLOCK_REQUEST
+ */
+struct xyz_cache_file_entry_ {
+	string *bytes; // content read by byte, NULL if not read
+	vector<string> *lines; // content read by line, NULL if not read
+	long size; // bytes held by this entry
+	int refs; // RDDs reading this file
+	long lastUsed;
+	time_t mtime; // modification time of the file when content was read
+	long fileSize; // size of the file when content was read
+	bool loading; // content being read from disk, without mutex_files held
+	int readers; // requests copying content, which is not freed meanwhile
+	int waiters; // requests waiting on cond
+	bool dropped; // released or cleared while in use, erased after the last reader
+	pthread_cond_t *cond; // signaled when loading finishes or the last reader leaves
+	xyz_cache_file_entry_()
+	: bytes(NULL), lines(NULL), size(0), refs(0), lastUsed(0), mtime(0), fileSize(-1),
+	  loading(false), readers(0), waiters(0), dropped(false), cond(NULL) { }
+	bool inUse() { return loading || readers > 0 || waiters > 0; } // must not be freed or erased
+};
+
+/*
+ * map output of a shuffle served by FETCH_REQUEST
+ */
+struct xyz_cache_shuffle_entry_ {
+	vector<DataCache *> caches; // one for each map task
+	int readers; // FETCH_REQUESTs being served
+	xyz_cache_shuffle_entry_() : readers(0) { }
+};
+
+/*
+ * CacheManager keeps data served to other nodes across jobs.
+ *
+ * Files are cached when first requested, and referenced by the RDDs reading them.
+ * A file is dropped when its last RDD releases it.
+ * Content is read again if the modification time or size of the file has changed.
+ * If cached files exceed XYZ_CACHE_MEMORY_BUDGET, unreferenced files are evicted first,
+ * then the least recently used ones, which are read again on the next request.
+ * Files are read from disk and copied without the global mutex held,
+ * an entry is only pinned under it, so requests on other files are not blocked.
+ *
+ * Shuffle caches are owned by shuffled RDDs, and registered here to be served.
+ * Only the RDD owning a shuffle reads its output, other RDDs of the lineage read that RDD,
+ * so a shuffle is not counted by reference, but released by its RDD before destroying map output,
+ * waiting for requests being served.
+ */
+class CacheManager {
+public:
+	CacheManager();
+	~CacheManager();
+
+	void retainFile(string path);
+	void releaseFile(string path);
+	void readFileBytes(string path, long offset, long length, string &ret);
+	void readFileLines(string path, long offset, long length, string &ret);
+	void clearFiles();
+
+	void saveShuffle(long shuffleID, DataCache *cache);
+	vector<DataCache *> * acquireShuffle(long shuffleID); // NULL if not cached
+	void releaseShuffleReader(long shuffleID);
+	void releaseShuffle(long shuffleID);
+	void clearShuffles();
+
+private:
+	map<string, xyz_cache_file_entry_> files;
+	long fileBytes; // bytes of all cached files
+	long clock; // for least recently used
+	map<long, xyz_cache_shuffle_entry_> shuffles;
+
+	pthread_mutex_t mutex_files, mutex_shuffles;
+	pthread_cond_t cond_shuffle_readers;
+
+	map<string, xyz_cache_file_entry_>::iterator findFile(string path); // created if not found
+	xyz_cache_file_entry_ & acquireFile(string path, bool byLine); // loaded and pinned
+	void releaseFileReader(string path);
+	void freeFile(xyz_cache_file_entry_ &entry);
+	void eraseFile(map<string, xyz_cache_file_entry_>::iterator it);
+	void evictFiles(string loading);
+};
+
+
+#endif /* HEADERS_CACHEMANAGER_H_ */
@@ -0,0 +1,29 @@
+/*
+ * CoalescedPartition.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_COALESCEDPARTITION_H_
+#define HEADERS_COALESCEDPARTITION_H_
+
+#include <vector>
+
+#include "Partition.h"
+using std::vector;
+
+/*
+ * Partition of CoalescedRDD.
+ * Made of several partitions of the previous RDD, computed one after another.
+ */
+class CoalescedPartition: public Partition {
+public:
+	CoalescedPartition(long rddID, int partitionID, vector<Partition*> &parents);
+
+	long rddID;
+	int partitionID;
+	vector<Partition*> parents; // partitions of the previous RDD
+};
+
+
+#endif /* HEADERS_COALESCEDPARTITION_H_ */
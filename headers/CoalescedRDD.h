@@ -0,0 +1,48 @@
+/*
+ * CoalescedRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_COALESCEDRDD_H_
+#define HEADERS_COALESCEDRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "CoalescedPartition.h"
+#include "RDD.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * Return type of RDD::coalesce.
+ * Partitions of previous RDD are grouped into fewer partitions without a shuffle.
+ * Partitions preferring the same host are grouped together where possible,
+ * so a task reads its partitions locally.
+ */
+template <class T>
+class CoalescedRDD : public RDD<T> {
+public:
+	CoalescedRDD(RDD<T> *prev, int numPartitions);
+	~CoalescedRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t countPartition(Partition *p);
+	IteratorSeq<T> * iteratorSeq(Partition *p);
+	void shuffle();
+
+private:
+	RDD<T> *prevRDD;
+	int numPartitions;
+
+	void coalesce(); // group partitions of previous RDD, known after it is shuffled
+};
+
+
+#endif /* HEADERS_COALESCEDRDD_H_ */
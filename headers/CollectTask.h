@@ -11,19 +11,19 @@
 using namespace std;
 
 /*
- * RDD::collect() creates and runs CollectTasks
+ * RDD::collect() and RDD::take() create and run CollectTasks
  */
 template <class T>
 class CollectTask : public RDDTask< T, vector<T> >
 {
 public:
-	    CollectTask(RDD<T> *r, Partition *p);
+	    CollectTask(RDD<T> *r, Partition *p, long limit = -1); // limit: most values to collect, -1 for all
 		vector<T> run();
 		string serialize(vector<T> &t); // serialize task result of type T
 		vector<T> deserialize(string &s); // deserialize task result from string
 
 private:
-
+		long limit;
 };
 
 #endif
@@ -0,0 +1,45 @@
+/*
+ * CombiningTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_COMBININGTASK_H_
+#define HEADERS_COMBININGTASK_H_
+
+#include <vector>
+
+#include "ShuffledTask.h"
+#include "FlatCombinerMap.h"
+#include "NodeCombiner.h"
+#include "Pair.h"
+using std::vector;
+
+int XYZ_SHUFFLE_MAP_SIDE_COMBINE = 1; // 0: off, 1: combine pairs of the same key in map tasks
+
+/*
+ * ShuffledRDD::shuffle creates and runs CombiningTasks if XYZ_SHUFFLE_MAP_SIDE_COMBINE is on.
+ * A CombiningTask merges combiners of the same key before they are shuffled,
+ * so each map task outputs one combiner per key.
+ * With a NodeCombiner, combiners are merged into it instead, and the task outputs nothing.
+ */
+template <class K, class V, class C>
+class CombiningTask : public ShuffledTask< Pair<K, V>, Pair<K, C> > {
+public:
+	CombiningTask(RDD< Pair<K, V> > *r, Partition *p, long shID, int nPs,
+			HashDivider &hashDivider,
+			Aggregator< Pair<K, V>, Pair<K, C> > &aggregator,
+			long (*hFunc)(Pair<K, C> &p),
+			string (*sf)(Pair<K, C> &p));
+	void setNodeCombiner(NodeCombiner<K, V, C> *nc);
+
+protected:
+	void addToPartition(int part, Pair<K, C> &p);
+	void finishPartitions();
+
+private:
+	vector< FlatCombinerMap<K, C> > combiners; // one for each new partition
+	NodeCombiner<K, V, C> *nodeCombiner; // combined output of this node, NULL if not used
+};
+
+#endif /* HEADERS_COMBININGTASK_H_ */
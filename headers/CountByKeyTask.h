@@ -0,0 +1,34 @@
+/*
+ * CountByKeyTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_COUNTBYKEYTASK_H_
+#define HEADERS_COUNTBYKEYTASK_H_
+
+#include <vector>
+
+#include "RDDTask.h"
+#include "Pair.h"
+using std::vector;
+
+/*
+ * RDD::countByValue and PairRDD::countByKey create and run CountByKeyTasks.
+ * Values of a partition are counted by key in a hash table,
+ * and only a pair of each distinct key and its count is sent back.
+ */
+template <class T, class K>
+class CountByKeyTask : public RDDTask< T, vector< Pair<K, long> > > {
+public:
+	CountByKeyTask(RDD<T> *r, Partition *p, K (*keyFunc)(T&));
+	vector< Pair<K, long> > run();
+	string serialize(vector< Pair<K, long> > &t);
+	vector< Pair<K, long> > deserialize(string &s);
+
+private:
+	K (*keyFunc)(T&); // key of a value
+};
+
+
+#endif /* HEADERS_COUNTBYKEYTASK_H_ */
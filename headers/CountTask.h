@@ -0,0 +1,26 @@
+/*
+ * CountTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_COUNTTASK_H_
+#define HEADERS_COUNTTASK_H_
+
+#include "RDDTask.h"
+
+/*
+ * RDD::count creates and runs CountTasks.
+ * Only the number of values in a partition is sent back.
+ */
+template <class T>
+class CountTask : public RDDTask<T, long> {
+public:
+	CountTask(RDD<T> *r, Partition *p);
+	long run();
+	string serialize(long &t);
+	long deserialize(string &s);
+};
+
+
+#endif /* HEADERS_COUNTTASK_H_ */
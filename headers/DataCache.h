@@ -19,6 +19,9 @@ class DataCache {
 public:
 	virtual ~DataCache();
 	virtual void getData(long dataIndex, string &result) = 0;
+	virtual size_t getDataSize(long dataIndex) = 0; // bytes of data, 0 if empty
+	virtual void appendData(long dataIndex, string &result) = 0; // append data to result
+	virtual void appendData(long dataIndex, size_t offset, size_t length, string &result) = 0; // append a piece of data
 };
 
 #endif /* HEADERS_DATACACHE_H_ */
@@ -0,0 +1,52 @@
+/*
+ * FilteredRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_FILTEREDRDD_H_
+#define HEADERS_FILTEREDRDD_H_
+
+#include <vector>
+#include <string>
+#include <pthread.h>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "HashDivider.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * Return type of RDD::filter.
+ * Keeping values of previous RDD passing filterFunction.
+ * Values are filtered as previous RDD computes them, if it supports so (e.g. MappedRDD),
+ * and the output is sized by the fraction of values passing in partitions computed before.
+ */
+template <class T>
+class FilteredRDD : public RDD<T> {
+public:
+	FilteredRDD(RDD<T> *prev, bool (*f)(T&));
+	~FilteredRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
+	IteratorSeq<T> * iteratorSeq(Partition *p);
+	void shuffle();
+	HashDivider * getPartitioner();
+
+private:
+	RDD<T> *prevRDD;
+	bool (*filterFunction)(T&);
+	long inputValues, outputValues; // counted over computed partitions
+	pthread_mutex_t mutex_selectivity;
+
+	double selectivity(); // expected fraction of values passing, negative if unknown
+};
+
+
+#endif /* HEADERS_FILTEREDRDD_H_ */
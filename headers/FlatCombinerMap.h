@@ -0,0 +1,44 @@
+/*
+ * FlatCombinerMap.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_FLATCOMBINERMAP_H_
+#define HEADERS_FLATCOMBINERMAP_H_
+
+#include <vector>
+#include <cstddef>
+
+#include "Pair.h"
+#include "Aggregator.h"
+using std::vector;
+
+/*
+ * An open-addressing hash table of combiners, used to combine pairs by key.
+ * Pairs are kept in one dense vector in insertion order,
+ * and the table holds their indexes only, probed linearly.
+ * Hashes of keys are stored, so most mismatches are rejected without comparing keys.
+ * When combining finishes, the dense vector is handed over as the result without copying.
+ */
+template <class K, class C>
+class FlatCombinerMap {
+public:
+	FlatCombinerMap();
+	Pair<K, C> * insert(Pair<K, C> &p, bool &inserted); // find the pair of the key, or insert p
+	template <class T> void merge(Pair<K, C> &p, Aggregator< T, Pair<K, C> > &agg); // merge p into its key
+	size_t size() const;
+	void swap(vector< Pair<K, C> > &v); // hand over pairs, this map becomes empty
+	void clear();
+
+private:
+	vector< Pair<K, C> > pairs; // in insertion order
+	vector<size_t> hashes; // hash of the key of each pair
+	vector<size_t> slots; // 0: empty, i + 1: pairs[i]
+	size_t mask; // slots.size() - 1
+
+	void rehash(size_t capacity);
+};
+
+
+#endif /* HEADERS_FLATCOMBINERMAP_H_ */
@@ -29,6 +29,8 @@ public:
 	~FlatMappedRDD();
 	vector<Partition *> getPartitions();
 	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
 	IteratorSeq<U> * iteratorSeq(Partition *p);
 	void shuffle();
 
@@ -0,0 +1,94 @@
+/*
+ * GroupedRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_GROUPEDRDD_H_
+#define HEADERS_GROUPEDRDD_H_
+
+#include "BaseShuffledRDD.h"
+#include "IteratorSeq.h"
+#include "VectorIteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+#include "SunwayMRContext.h"
+#include "Aggregator.h"
+#include "HashDivider.h"
+#include "ShuffledPartition.h"
+#include "ShuffledTask.h"
+#include "MapStatus.h"
+#include "MessageDecoder.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <pthread.h>
+#include <tr1/unordered_map>
+using namespace std;
+using std::tr1::unordered_map;
+
+template <class K, class V> class GroupedRDD;
+
+/*
+ * to append values of serialized pairs to the groups of their keys while they are decoded,
+ * from output buffers of local map tasks or from fetched data.
+ */
+template <class K, class V>
+class GroupedDataDecoder : public RecordDecoder {
+public:
+	GroupedDataDecoder(GroupedRDD<K, V> *rdd, unordered_map<K, size_t> &index,
+			vector<K> &keys, deque< vector<V> > &groups);
+	int getInvalid();
+
+protected:
+	void record(string &s);
+
+private:
+	GroupedRDD<K, V> *rdd;
+	unordered_map<K, size_t> &index; // key -> position in keys and groups
+	vector<K> &keys;
+	deque< vector<V> > &groups;
+	int invalid; // records failed to convert
+};
+
+/*
+ * GroupedRDD collects all values of the same key into one VectorIteratorSeq.
+ * Pairs are shuffled as they are, without map-side combiners,
+ * and values are appended to the group of their key when merging.
+ * PairRDD::groupByKey will generate GroupedRDD.
+ */
+template <class K, class V>
+class GroupedRDD : public BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, VectorIteratorSeq<V> > >
+{
+public:
+	GroupedRDD(RDD< Pair<K, V> > *_prevRDD,
+			HashDivider &_hd,
+			long (*hf)(Pair<K, V> &p),
+			string (*strf)(Pair<K, V> &p),
+			Pair<K, V> (*_recoverFunc)(string &s));
+	IteratorSeq< Pair<K, VectorIteratorSeq<V> > > * iteratorSeq(Partition *p);
+	HashDivider * getPartitioner();
+	void setJoinSides(int leftTasks);
+
+	friend class GroupedDataDecoder<K, V>;
+
+protected:
+	void afterMapStage();
+
+private:
+	Aggregator< Pair<K, V>, Pair<K, V> > agg;
+	long (*hashFunc)(Pair<K, V> &p); // function to compute hashCode of a pair
+	string (*strFunc)(Pair<K, V> &p); // function to serialize a pair to string
+	Pair<K, V> (*recoverFunc)(string &s); // function to deserialize a string to a pair
+	int joinLeftTasks; // map tasks [0, joinLeftTasks) read the left side of a join, 0 if not a join
+
+	void splitPartitions(); // split skewed or, if adaptive, large partitions of a join
+
+	void append(Pair<K, V> &p, unordered_map<K, size_t> &index,
+			vector<K> &keys, deque< vector<V> > &groups); // append a value to the group of its key
+};
+
+#endif /* HEADERS_GROUPEDRDD_H_ */
@@ -37,6 +37,7 @@ public:
 
 	template <class U> IteratorSeq<U> * map(U (*f)(T&));
 	template <class U> IteratorSeq<U> * flatMap(vector<U> (*f)(T&));
+	IteratorSeq<T> * filter(bool (*f)(T&), size_t expected); // expected: elements passing, to reserve
 
 	bool operator==(const IteratorSeq<T> &s) const;
 };
@@ -37,6 +37,7 @@ public:
 	int getListenPort();
 	virtual int totalThreads();
 	vector<string> getHosts();
+	vector<string> getTaskHosts(int taskNum);
 
 	template <class T> vector< TaskResult<T>* > runTasks(vector< Task<T>* > &tasks);
 
@@ -58,6 +59,8 @@ private:
 			int msgType, string &msg); // override Messaging
 	void handleMessage(int localListenPort, string fromHost,
 			int msgType, string &msg, int &retValue); // override Scheduler
+	MessageDecoder * createDecoder(int localListenPort, string fromHost,
+			int msgType); // override Messaging and Scheduler
 };
 
 
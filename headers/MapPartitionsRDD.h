@@ -0,0 +1,49 @@
+/*
+ * MapPartitionsRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_MAPPARTITIONSRDD_H_
+#define HEADERS_MAPPARTITIONSRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * Return type of RDD::mapPartitions and RDD::mapPartitionsWithIndex.
+ * The function is called once per partition with all values of the partition,
+ * and appends the new values to the output vector.
+ * So, set up done per partition (tables, buffers, random seeds) is not repeated per value.
+ */
+template <class U, class T>
+class MapPartitionsRDD : public RDD<U> {
+public:
+	MapPartitionsRDD(RDD<T> *prev, void (*f)(IteratorSeq<T>&, vector<U>&));
+	MapPartitionsRDD(RDD<T> *prev, void (*f)(int, IteratorSeq<T>&, vector<U>&));
+	~MapPartitionsRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
+	IteratorSeq<U> * iteratorSeq(Partition *p);
+	void shuffle();
+
+private:
+	RDD<T> *prevRDD;
+	void (*partitionFunction)(IteratorSeq<T>&, vector<U>&); // NULL if with index
+	void (*indexedPartitionFunction)(int, IteratorSeq<T>&, vector<U>&); // NULL if without index
+
+	int partitionIndex(Partition *p); // index of the partition in previous RDD
+};
+
+
+#endif /* HEADERS_MAPPARTITIONSRDD_H_ */
@@ -0,0 +1,63 @@
+/*
+ * MapStatus.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_MAPSTATUS_H_
+#define HEADERS_MAPSTATUS_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+using std::string;
+using std::vector;
+using std::map;
+using std::pair;
+
+#ifndef MAP_STATUS_DELIMITATION
+#define MAP_STATUS_DELIMITATION "\aMAP_STATUS\a"
+#endif
+
+int XYZ_SHUFFLE_ADAPTIVE_MODE = 0; // 0: off, 1: coalesce small and split large reduce partitions by map output sizes
+int XYZ_SHUFFLE_ADAPTIVE_PARTITION_FACTOR = 4; // map output partitions = factor * total threads
+long XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES = 64L << 20; // advisory size of a reduce partition
+long XYZ_SHUFFLE_ADAPTIVE_MIN_BYTES = 1L << 20; // reduce partitions are not made smaller than this
+int XYZ_SHUFFLE_LOCALITY_MODE = 1; // 0: off, 1: run reduce tasks where most of their input is
+double XYZ_SHUFFLE_LOCALITY_FRACTION = 0.2; // hosts holding less of a reduce partition are not preferred
+int XYZ_SHUFFLE_SKEW_MODE = 1; // 0: off, 1: split partitions far larger than the others after the map stage
+double XYZ_SHUFFLE_SKEW_FACTOR = 4.0; // skewed if bytes of a partition > factor * median
+long XYZ_SHUFFLE_SKEW_MIN_BYTES = 1L << 20; // partitions with fewer bytes are never split
+
+/*
+ * Result of a ShuffledTask.
+ * Tells where the map task ran, and how much it wrote to each new partition.
+ */
+class MapStatus {
+public:
+	MapStatus();
+	MapStatus(int numPartitions);
+
+	static void coalescePartitions(vector<MapStatus> &statuses, int parallelism,
+			vector<int> &starts); // plan reduce partitions by sizes of map output
+	static vector<long> partitionBytes(vector<MapStatus> &statuses,
+			int firstTask, int lastTask); // bytes of each partition written by map tasks in a range
+	static vector<int> skewedPartitions(vector<long> &bytes,
+			long &median); // partitions far larger than the median
+	static vector<int> partitionSlices(vector<long> &bytes, bool adaptive, int parallelism,
+			long &median); // slices to split each partition into, 1 if not split
+	static void splitTasks(vector<MapStatus> &statuses, int partition, int firstTask, int lastTask,
+			int slices, vector<int> &starts); // ranges of map tasks writing about the same bytes
+	static vector<string> preferredHosts(vector<MapStatus> &statuses,
+			int firstPartition, int lastPartition,
+			const vector< pair<int, int> > &taskRanges); // hosts holding most of the partitions
+
+	string host; // where the map task ran
+	vector<long> records; // records of each new partition
+	vector<long> bytes; // serialized bytes of each new partition
+	bool failed; // the map output was lost, the task must run again
+};
+
+
+#endif /* HEADERS_MAPSTATUS_H_ */
@@ -30,7 +30,11 @@ public:
 	~MappedRDD();
 	vector<Partition*> getPartitions();
 	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
+	size_t countPartition(Partition *p);
 	IteratorSeq<U> * iteratorSeq(Partition *p);
+	IteratorSeq<U> * filteredIteratorSeq(Partition *p, bool (*f)(U&), double selectivity, size_t &count);
 	void shuffle();
 
 private:
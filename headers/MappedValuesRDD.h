@@ -0,0 +1,48 @@
+/*
+ * MappedValuesRDD.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef HEADERS_MAPPEDVALUESRDD_H_
+#define HEADERS_MAPPEDVALUESRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+#include "HashDivider.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * Return type of PairRDD::mapValues with a function of values.
+ * Mapping mappedFunction to the value of each pair, the key is kept as it is,
+ * so the partitioner of previous RDD holds.
+ */
+template <class K, class U, class V>
+class MappedValuesRDD : public RDD< Pair<K, U> > {
+public:
+	MappedValuesRDD(RDD< Pair<K, V> > *prev, U (*f)(V&));
+	~MappedValuesRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
+	size_t countPartition(Partition *p);
+	IteratorSeq< Pair<K, U> > * iteratorSeq(Partition *p);
+	void shuffle();
+	HashDivider * getPartitioner();
+
+private:
+	RDD< Pair<K, V> > *prevRDD;
+	U (*mappedFunction)(V&);
+};
+
+
+#endif /* HEADERS_MAPPEDVALUESRDD_H_ */
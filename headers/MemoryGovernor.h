@@ -0,0 +1,59 @@
+/*
+ * MemoryGovernor.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_MEMORYGOVERNOR_H_
+#define HEADERS_MEMORYGOVERNOR_H_
+
+#include <vector>
+#include <pthread.h>
+using namespace std;
+
+size_t XYZ_MEMORY_UNIT = 1024 * 1024; // bytes of a unit of memory in the host file
+
+/*
+ * an abstract class of holders of memory acquired from MemoryGovernor,
+ * which can free some of it when memory runs short.
+ */
+class MemoryConsumer {
+public:
+	virtual ~MemoryConsumer();
+	virtual size_t spill(size_t bytes, bool idle) = 0; // free about bytes of acquired memory, return bytes freed.
+			// idle: no task is running, so data tasks may be reading can be freed too
+};
+
+/*
+ * MemoryGovernor keeps memory of a node within its budget from the host file.
+ * running tasks reserve their working set before they are launched,
+ * and data kept after tasks (shuffle output, persisted partitions) is acquired.
+ * when the budget would be exceeded, consumers are asked to spill,
+ * then new tasks are delayed and new data is not kept in memory.
+ */
+class MemoryGovernor {
+public:
+	MemoryGovernor();
+	~MemoryGovernor();
+	void setBudget(size_t bytes); // 0: no limit
+	size_t getBudget();
+	size_t getUsed(); // reserved and acquired
+	bool reserve(size_t bytes, bool force); // for a task to run, always done if forced
+	void release(size_t bytes); // reserved by a finished task
+	bool acquire(size_t bytes); // for data kept in memory
+	void releaseAcquired(size_t bytes);
+	void addConsumer(MemoryConsumer *c);
+	void removeConsumer(MemoryConsumer *c);
+
+private:
+	size_t budget;
+	size_t reserved; // by running tasks
+	size_t acquired; // by data kept in memory
+	vector<MemoryConsumer *> consumers;
+	pthread_mutex_t mutex;
+
+	bool fits(size_t bytes); // with mutex locked
+	void spill(size_t bytes, bool idle); // with mutex locked
+};
+
+#endif /* HEADERS_MEMORYGOVERNOR_H_ */
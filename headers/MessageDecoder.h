@@ -0,0 +1,44 @@
+/*
+ * MessageDecoder.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_MESSAGEDECODER_H_
+#define HEADERS_MESSAGEDECODER_H_
+
+#include <string>
+using namespace std;
+
+/*
+ * an abstract class to decode a message while it is received.
+ * decode is called with each chunk read from the socket, finish after the last one,
+ * so a large message is never held in memory as a whole.
+ */
+class MessageDecoder {
+public:
+	virtual ~MessageDecoder();
+	virtual void decode(const char *data, size_t size) = 0;
+	virtual void finish() = 0; // end of a message
+};
+
+/*
+ * a MessageDecoder of messages made of records with a delimitation between them.
+ * only the record not yet received completely is kept.
+ */
+class RecordDecoder : public MessageDecoder {
+public:
+	RecordDecoder(string delimitation);
+	void decode(const char *data, size_t size);
+	void finish();
+
+protected:
+	virtual void record(string &s) = 0; // called with each record, in order
+
+private:
+	string delimitation;
+	string pending; // received bytes of the next record
+	string current; // a record received completely, reused for every record
+};
+
+#endif /* HEADERS_MESSAGEDECODER_H_ */
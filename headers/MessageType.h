@@ -19,9 +19,10 @@ enum MessageType {
 	A_TASK_RESULT, // jobID taskID valueString
 	TASK_RESULT_LIST, // jobID taskID1 valueString1,jobID taskID2 valueString2,jobID taskID3 valueString3
 	FILE_BLOCK_REQUEST, // path|offset|length
-	FETCH_REQUEST, // shuffleID,partitionID
+	FETCH_REQUEST, // shuffleID,partitionID[,firstTask,lastTask]
 	RESULT_RENEED, //
-	RESULT_RENEED_TOTAL //
+	RESULT_RENEED_TOTAL, //
+	SHUFFLE_PUSH // shuffleID,taskID partitionID1 data1 partitionID2 data2
 };
 
 #endif /* MESSAGETYPE_H_ */
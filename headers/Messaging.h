@@ -16,6 +16,8 @@ using namespace std;
 
 #include "MessageType.h"
 #include "DataCache.h"
+#include "CacheManager.h"
+#include "MessageDecoder.h"
 
 #ifndef END_OF_MESSAGE
 #define END_OF_MESSAGE "\aEND_OF_MESSAGE\a"
@@ -26,6 +28,11 @@ using namespace std;
 #ifndef FILE_BLOCK_REQUEST_DELIMITATION
 #define FILE_BLOCK_REQUEST_DELIMITATION "\aFILE_BLOCK_REQUEST\a"
 #endif
+#ifndef SHUFFLE_PUSH_DELIMITATION
+#define SHUFFLE_PUSH_DELIMITATION "\aSHUFFLE_PUSH\a"
+#endif
+
+size_t XYZ_MESSAGING_CHUNK_SIZE = 1024 * 1024; // bytes sent or received at a time
 
 enum ListenStatus {
 	NA,
@@ -51,6 +58,28 @@ struct xyz_messaging_listen_thread_data_ {
 
 void* messageHandler(void *fd);
 
+/*
+ * to send a message in chunks of XYZ_MESSAGING_CHUNK_SIZE bytes to a socket.
+ * data is copied into the chunk as it is serialized, and sent when the chunk is full,
+ * so a large message is never held in memory as a whole.
+ */
+class ChunkedWriter {
+public:
+	ChunkedWriter(int socket_fd);
+	void write(const char *data, size_t size);
+	void write(const string &s);
+	void write(DataCache *cache, long dataIndex); // write data of a cache piece by piece
+	bool flush(); // send the chunk
+	size_t written(); // bytes written, sent or not
+	bool failed();
+
+private:
+	int socket_fd;
+	string chunk;
+	size_t total;
+	bool error;
+};
+
 /*
  *
  * A useful base class to send and listen socket messages.
@@ -62,12 +91,23 @@ public:
 	virtual ~Messaging();
 
 	void saveShuffleCache(long shuffleID, DataCache *cache);
+	void releaseShuffleCache(long shuffleID);
+	void retainFileCache(string path);
+	void releaseFileCache(string path);
 	void clearAllCache();
 	void clearFileCache();
 	void clearShuffleCache();
 
 	bool sendMessageForReply(string addr, int targetPort, int msgType, string &msg, string &reply);
+	bool sendMessageForReply(string addr, int targetPort, int msgType, string &msg, MessageDecoder &decoder);
+	int beginMessage(string addr, int targetPort, int msgType); // connect and send message type
+	bool endMessage(int socket_fd); // finish a message begun, and wait a reply
 	bool sendMessage(string addr, int targetPort, int msgType, string &msg);
+	void fetchShuffleData(vector<string> &hosts, int targetPort,
+			long shuffleID, int partitionID, int firstTask, int lastTask, MessageDecoder &decoder);
+	void savePushedShuffleData(long shuffleID, long taskID, int partitionID, string &data);
+	void takePushedShuffleData(long shuffleID, int partitionID, map<long, string> &blocks); // task ID -> block
+	void clearPushedShuffleData(long shuffleID);
 
 	/*
 	 listen a port.
@@ -78,18 +118,17 @@ public:
 	int getListenStatus();
 
 	virtual void messageReceived(int localListenPort, string fromHost, int msgType, string &msg) = 0;
+	virtual MessageDecoder * createDecoder(int localListenPort, string fromHost, int msgType); // NULL: receive whole messages
 
-	pthread_mutex_t mutex_listen_status, mutex_check_file_cache;
-
-
-	map<string, string*> file_cache_bytes;
-	map<string, vector<string>*> file_cache_lines;
+	pthread_mutex_t mutex_listen_status, mutex_shuffle_push;
 
-	map< long, vector<DataCache *> > shuffle_cache;
+	CacheManager cacheManager; // files and shuffle data served to other nodes
+	map< long, map< int, map<long, string> > > shuffle_push_cache; // shuffleID -> partitionID -> taskID -> data
 private:
 	int listenStatus;
 
 	bool sendMessageInternal(int socket_fd, string addr, int targetPort, int msgType, string &msg);
+	bool connectMessage(int socket_fd, string addr, int targetPort, int msgType);
 };
 
 
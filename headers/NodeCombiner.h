@@ -0,0 +1,60 @@
+/*
+ * NodeCombiner.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_NODECOMBINER_H_
+#define HEADERS_NODECOMBINER_H_
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "DataCache.h"
+#include "Aggregator.h"
+#include "FlatCombinerMap.h"
+#include "Pair.h"
+using std::string;
+using std::vector;
+
+int XYZ_SHUFFLE_NODE_COMBINE = 0; // 0: off, 1: combine output of all map tasks on a node
+
+/*
+ * NodeCombiner holds combined output of all map tasks that ran on this node.
+ * CombiningTasks merge their combiners into it, one lock for each new partition,
+ * so tasks merging different partitions do not block each other.
+ * Fetch requests are served one block for each partition from here, instead of one block per map task.
+ * Only used if map tasks run by threads, so they share this process.
+ */
+template <class K, class V, class C>
+class NodeCombiner : public DataCache {
+public:
+	NodeCombiner(int nPs, Aggregator< Pair<K, V>, Pair<K, C> > &aggregator,
+			string (*sf)(Pair<K, C> &p));
+	~NodeCombiner();
+
+	void merge(int part, vector< Pair<K, C> > &pairs); // merge combiners of a map task
+	vector< Pair<K, C> > & getPartitionData(int part);
+
+	void getData(long cacheIndex, string &result);
+	size_t getDataSize(long cacheIndex);
+	void appendData(long cacheIndex, string &result);
+	void appendData(long cacheIndex, size_t offset, size_t length, string &result);
+
+private:
+	int numPartitions;
+	Aggregator< Pair<K, V>, Pair<K, C> > agg;
+	string (*strFunc)(Pair<K, C> &p);
+	vector< FlatCombinerMap<K, C> > combiners; // one for each new partition
+	vector<pthread_mutex_t> mutexes; // one for each new partition
+	vector< vector< Pair<K, C> > > partitions; // combined pairs, after all map tasks merged
+	string output; // serialized partitions
+	vector<size_t> outputIndex; // offset of each partition in output, and the end
+	bool finished;
+	pthread_mutex_t finishMutex;
+
+	void finish();
+};
+
+#endif /* HEADERS_NODECOMBINER_H_ */
@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include "IteratorSeq.h"
 #include "VectorIteratorSeq.h"
@@ -17,13 +18,18 @@
 #include "RDD.h"
 #include "Pair.h"
 #include "MappedRDD.h"
+#include "MappedValuesRDD.h"
 #include "Either.h"
+#include "HashDivider.h"
+#include "SampledByKeyRDD.h"
 
 using std::vector;
 using std::string;
 
 template <class T> class RDD;
 template <class U, class T> class MappedRDD;
+template <class K, class U, class V> class MappedValuesRDD;
+template <class K, class V> class SampledByKeyRDD;
 
 /*
  * Return type of RDD::mapToPair.
@@ -36,13 +42,22 @@ public:
 	~PairRDD();
 	vector<Partition *> getPartitions();
 	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t inputBytes(Partition *p);
+	size_t countPartition(Partition *p);
 	IteratorSeq< Pair<K, V> > * iteratorSeq(Partition *p);
 	void shuffle();
+	HashDivider * getPartitioner();
 
 	template <class U>
-	PairRDD<K, U, Pair<K, V> > * mapValues(Pair<K, U> (*f)(Pair<K, V> &)); // change value's type
+	PairRDD<K, U, Pair<K, V> > * mapValues(Pair<K, U> (*f)(Pair<K, V> &)); // map pairs, the partitioner is not kept
+	template <class U>
+	PairRDD<K, U, Pair<K, U> > * mapValues(U (*f)(V &)); // map values only, the partitioner is kept
 
 	MappedRDD<V, Pair< K, V > > * values(); // get all values
+	std::map<K, long> countByKey(); // count pairs of each key
+	SampledByKeyRDD<K, V> * sampleByKey(bool withReplacement,
+			std::map<K, double> &fractions, long seed); // sample with the fraction of each key
 
 	template <class C>
 	PairRDD<K, C, Pair<K, C> > * combineByKey(
@@ -60,6 +75,12 @@ public:
 
 	PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * groupByKey(); // shuffle operator
 
+	PairRDD<K, V, Pair<K, V> > * sortByKey(bool ascending, int numPartitions); // shuffle operator
+
+	PairRDD<K, V, Pair<K, V> > * sortByKey(bool ascending); // shuffle operator
+
+	PairRDD<K, V, Pair<K, V> > * sortByKey(); // shuffle operator, ascending
+
 	template <class W>
 	PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * join(
 			RDD< Pair< K, W > > *other,
@@ -69,9 +90,31 @@ public:
 	PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * join(
 			RDD< Pair< K, W > > *other); // join two PairRDD
 
+	template <class W>
+	PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * broadcastJoin(
+			RDD< Pair< K, W > > *small); // join with a small RDD, without shuffle
+
 private:
+	template <class K1, class V1, class T1> friend class PairRDD; // for private shuffle operators
+
 	RDD<T> *prevRDD;
 	Pair<K, V> (*mapToPairFunction)(T&);
+
+	int defaultPartitions(bool &adaptive); // partition number of shuffle operators if not specified
+
+	template <class C>
+	PairRDD<K, C, Pair<K, C> > * combineByKey(
+			Pair<K, C> (*createCombiner)(Pair<K, V>&),
+			Pair<K, C> (*mergeCombiner)(Pair<K, C>&, Pair<K, C>&),
+			int numPartitions, bool adaptive);
+
+	PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * groupByKey(
+			int num_partitions, bool adaptive);
+
+	template <class W>
+	PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * shuffleJoin(
+			RDD< Pair< K, W > > *other,
+			int num_partitions, bool adaptive);
 };
 
 
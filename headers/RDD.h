@@ -10,25 +10,49 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <pthread.h>
 
 #include "IteratorSeq.h"
+#include "VectorIteratorSeq.h"
 #include "MappedRDD.h"
 #include "FlatMappedRDD.h"
+#include "MapPartitionsRDD.h"
+#include "FilteredRDD.h"
+#include "SampledRDD.h"
+#include "CoalescedRDD.h"
 #include "PairRDD.h"
 #include "Partition.h"
 #include "SunwayMRContext.h"
 #include "UnionRDD.h"
+#include "HashDivider.h"
+#include "MemoryGovernor.h"
 using std::string;
 using std::vector;
 
 
 template <class U, class T> class MappedRDD;
 template <class U, class T> class FlatMappedRDD;
+template <class U, class T> class MapPartitionsRDD;
+template <class T> class FilteredRDD;
+template <class T> class SampledRDD;
+template <class T> class CoalescedRDD;
 template <class K, class V, class T> class PairRDD;
 class SunwayMRContext;
 
 long XYZ_CURRENT_RDD_ID = 1; // id counter
+int XYZ_TAKE_SCALE_UP_FACTOR = 4; // most times partitions scanned by a job of take grow
+string XYZ_RDD_STORAGE_DIR = "sunwaymrstorage/"; // directory of partitions persisted on disk
+
+/*
+ * how computed partitions of a persisted RDD are kept on each node.
+ */
+enum StorageLevel {
+	STORAGE_NONE, // not kept, computed every time
+	STORAGE_MEMORY_ONLY, // IteratorSeqs kept as they are computed, while they fit in the memory budget
+	STORAGE_MEMORY_ONLY_SER, // kept serialized in memory
+	STORAGE_DISK_ONLY // serialized to local files, which outlive forked task processes
+};
 
 /*
  * Abstract super class of all other RDD classes.
@@ -39,7 +63,7 @@ long XYZ_CURRENT_RDD_ID = 1; // id counter
  * Some operator will return a new RDD.
  */
 template <class T>
-class RDD {
+class RDD : public MemoryConsumer {
 public:
 	RDD(SunwayMRContext *c);
 	RDD<T> & operator=(const RDD<T> &r);
@@ -48,16 +72,43 @@ public:
 	virtual vector<Partition*> getPartitions()=0;
 	virtual vector<string> preferredLocations(Partition *p)=0;
 	virtual IteratorSeq<T> * iteratorSeq(Partition *p)=0;
+	IteratorSeq<T> * getOrCompute(Partition *p); // stored data of a persisted partition, or iteratorSeq
+	virtual size_t countPartition(Partition *p); // number of values in the partition
+	virtual IteratorSeq<T> * filteredIteratorSeq(Partition *p, bool (*f)(T&),
+			double selectivity, size_t &count); // new IteratorSeq of values passing f, owned by the caller
+	vector<string> getPreferredLocations(Partition *p); // host storing the partition first, then preferredLocations
+	virtual void partitionScheduled(Partition *p, string host); // a task on the partition is to run at host
+	virtual size_t inputBytes(Partition *p); // bytes read to compute the partition, 0 if unknown
 
 	template <class U> MappedRDD<U, T> * map(U (*f)(T&));
 	template <class U> FlatMappedRDD<U, T> * flatMap(vector<U> (*f)(T&));
+	template <class U> MapPartitionsRDD<U, T> * mapPartitions(void (*f)(IteratorSeq<T>&, vector<U>&));
+	template <class U> MapPartitionsRDD<U, T> * mapPartitionsWithIndex(void (*f)(int, IteratorSeq<T>&, vector<U>&));
+	FilteredRDD<T> * filter(bool (*f)(T&));
+	SampledRDD<T> * sample(bool withReplacement, double fraction, long seed);
 	template <class K, class V> PairRDD<K, V, T> * mapToPair(Pair<K, V> (*f)(T&));
 	T reduce(T (*g)(T&, T&));
+	template <class U> U aggregate(U zero, U (*seqOp)(U&, T&), U (*combOp)(U&, U&));
+	template <class U> U treeAggregate(U zero, U (*seqOp)(U&, T&), U (*combOp)(U&, U&),
+			int depth = 2); // partitions on a host are merged before results are sent
+	T fold(T zero, T (*op)(T&, T&));
 	virtual void shuffle();
+	virtual HashDivider * getPartitioner(); // how keys are hash partitioned, NULL if unknown
+
+	CoalescedRDD<T> * coalesce(int numPartitions); // fewer partitions, without a shuffle
+	RDD<T> * repartition(int numPartitions); // even partitions, by a shuffle
 
 	MappedRDD<T, Pair< T, int > > * distinct(int newNumSlices);
 	MappedRDD<T, Pair< T, int > > * distinct(); // by default, newNumSlices = partitions.size()
 	vector<T> collect();
+	vector<T> take(long n); // first n values, scanning as few partitions as possible
+	T first();
+	vector<T> top(long k, bool (*less)(T&, T&)); // k largest values by less, in descending order
+	vector<T> top(long k); // by operator<
+	vector<T> takeOrdered(long k, bool (*less)(T&, T&)); // k smallest values by less, in ascending order
+	vector<T> takeOrdered(long k); // by operator<
+	long count();
+	std::map<T, long> countByValue(); // T must be hashable by std::tr1::hash
 
 	UnionRDD<T> * unionRDD(RDD<T> *other);
 
@@ -67,6 +118,12 @@ public:
 
 	bool isSticky();
 	void setSticky(bool s);
+
+	void persist(StorageLevel level);
+	void cache(); // persist in memory, no serialization needed
+	void unpersist();
+	StorageLevel getStorageLevel();
+	size_t spill(size_t bytes, bool idle); // drop deserialized copies if idle, then partitions stored serialized in memory
 protected:
 	void addIteratorSeq(IteratorSeq<T> * i);
 
@@ -75,6 +132,24 @@ private:
 	bool sticky;
 	pthread_mutex_t mutex_iterator_seqs;
 
+	StorageLevel storageLevel;
+	string storagePath; // prefix of files, with STORAGE_DISK_ONLY
+	std::map<Partition *, IteratorSeq<T> *> storedSeqs; // STORAGE_MEMORY_ONLY
+	std::map<Partition *, size_t> storedSeqBytes; // estimated size of storedSeqs, acquired from XYZ_MEMORY_GOVERNOR
+	std::map<Partition *, string> storedBlocks; // STORAGE_MEMORY_ONLY_SER, acquired from XYZ_MEMORY_GOVERNOR
+	std::map<Partition *, IteratorSeq<T> *> loadedSeqs; // deserialized from storedBlocks or files, owned
+	std::map<Partition *, size_t> loadedBytes; // of loadedSeqs, acquired from XYZ_MEMORY_GOVERNOR
+	std::map<Partition *, string> storedHosts; // host each persisted partition is computed at
+	pthread_mutex_t mutex_storage;
+	string (*storageToString)(IteratorSeq<T> &seq);
+	void (*storageFromString)(VectorIteratorSeq<T> &seq, string &s);
+
+	IteratorSeq<T> * getStored(Partition *p); // NULL if not stored on this node
+	void store(Partition *p, IteratorSeq<T> *seq);
+	string storageFile(Partition *p);
+	void setStorageLevel(StorageLevel level);
+
+	vector<T> ordered(long k, bool (*less)(T&, T&), bool largest); // top or takeOrdered
 	void clean();
 	void deletePartitions();
 	void deleteIteratorSeqs();
@@ -29,6 +29,8 @@ public:
 	virtual string serialize(U &t) = 0;
 	virtual U deserialize(string &s) = 0;
 	virtual vector<string> preferredLocations();
+	virtual void scheduled(string host);
+	virtual size_t memoryExpected();
 
 	RDD<T> *rdd;
 	Partition *partition;
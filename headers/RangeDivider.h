@@ -0,0 +1,37 @@
+/*
+ * RangeDivider.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_RANGEDIVIDER_H_
+#define HEADERS_RANGEDIVIDER_H_
+
+#include <vector>
+using std::vector;
+
+/*
+ * Get partition index by the range a key falls in.
+ * Range bounds are chosen from sampled keys, so that
+ * partitions of a sorted RDD hold roughly the same number of pairs.
+ */
+template <class K>
+class RangeDivider
+{
+public:
+	RangeDivider(int partitions, bool ascending);
+	int getNumPartitions();
+	int getPartition(K &k);
+	void setBounds(vector<K> &samples); // choose bounds from sampled keys
+	vector<K> getBounds();
+	bool isAscending();
+	bool equals(RangeDivider<K> &rd);
+
+private:
+	int numPartitions;
+	bool ascending;
+	vector<K> bounds; // sorted upper bounds of each partition, except the last one
+};
+
+
+#endif /* HEADERS_RANGEDIVIDER_H_ */
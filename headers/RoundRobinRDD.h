@@ -0,0 +1,48 @@
+/*
+ * RoundRobinRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_ROUNDROBINRDD_H_
+#define HEADERS_ROUNDROBINRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * Used by RDD::repartition.
+ * Each value of previous RDD is paired with the partition it is shuffled to,
+ * in round robin from the index of its partition,
+ * so every new partition gets a nearly equal share of every previous partition.
+ */
+template <class T>
+class RoundRobinRDD : public RDD< Pair<long, T> > {
+public:
+	RoundRobinRDD(RDD<T> *prev, int numPartitions);
+	~RoundRobinRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	size_t countPartition(Partition *p);
+	IteratorSeq< Pair<long, T> > * iteratorSeq(Partition *p);
+	void shuffle();
+
+private:
+	RDD<T> *prevRDD;
+	int numPartitions;
+
+	int partitionIndex(Partition *p); // index of the partition in previous RDD
+};
+
+
+#endif /* HEADERS_ROUNDROBINRDD_H_ */
@@ -0,0 +1,34 @@
+/*
+ * SampleTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SAMPLETASK_H_
+#define HEADERS_SAMPLETASK_H_
+
+#include <vector>
+
+#include "RDDTask.h"
+#include "Pair.h"
+using std::vector;
+
+/*
+ * SortedRDD::shuffle creates and runs SampleTasks.
+ * A SampleTask picks keys evenly spaced in a partition of pairs,
+ * which are used to choose bounds of RangeDivider.
+ */
+template <class K, class V>
+class SampleTask : public RDDTask< Pair<K, V>, vector<K> > {
+public:
+	SampleTask(RDD< Pair<K, V> > *r, Partition *p, size_t sampleSize);
+	vector<K> run();
+	string serialize(vector<K> &t);
+	vector<K> deserialize(string &s);
+
+private:
+	size_t sampleSize; // max number of keys sampled from the partition
+};
+
+
+#endif /* HEADERS_SAMPLETASK_H_ */
@@ -0,0 +1,37 @@
+/*
+ * SampledByKeyRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SAMPLEDBYKEYRDD_H_
+#define HEADERS_SAMPLEDBYKEYRDD_H_
+
+#include <map>
+
+#include "SampledRDD.h"
+#include "RDD.h"
+#include "Pair.h"
+
+template <class T> class RDD;
+
+/*
+ * Return type of PairRDD::sampleByKey.
+ * Sampling like SampledRDD, with the fraction of each key.
+ * Pairs of keys without a fraction are not kept.
+ */
+template <class K, class V>
+class SampledByKeyRDD : public SampledRDD< Pair<K, V> > {
+public:
+	SampledByKeyRDD(RDD< Pair<K, V> > *prev, bool withReplacement,
+			std::map<K, double> &fractions, long seed);
+
+protected:
+	double fractionOf(Pair<K, V> &p);
+
+private:
+	std::map<K, double> fractions;
+};
+
+
+#endif /* HEADERS_SAMPLEDBYKEYRDD_H_ */
@@ -0,0 +1,56 @@
+/*
+ * SampledRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SAMPLEDRDD_H_
+#define HEADERS_SAMPLEDRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "HashDivider.h"
+#include "XoshiroRandom.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+double XYZ_SAMPLE_GAP_FRACTION = 0.4; // uniform sampling without replacement below it skips gaps of values
+
+/*
+ * Return type of RDD::sample.
+ * Without replacement, each value of previous RDD is kept with probability fraction,
+ * with replacement, it is kept a Poisson number of times, of mean fraction.
+ * Random numbers of a partition come from a stream of the seed and the partition index,
+ * so the sample is the same wherever and whenever the partition is computed.
+ */
+template <class T>
+class SampledRDD : public RDD<T> {
+public:
+	SampledRDD(RDD<T> *prev, bool withReplacement, double fraction, long seed);
+	~SampledRDD();
+	vector<Partition*> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	IteratorSeq<T> * iteratorSeq(Partition *p);
+	void shuffle();
+	HashDivider * getPartitioner();
+
+protected:
+	RDD<T> *prevRDD;
+	bool withReplacement;
+	double fraction;
+	long seed;
+	bool uniform; // false if fractionOf is overridden
+
+	virtual double fractionOf(T &t); // expected times the value is kept
+	int partitionIndex(Partition *p); // index of the partition in previous RDD
+};
+
+
+#endif /* HEADERS_SAMPLEDRDD_H_ */
@@ -9,9 +9,12 @@
 #define SCHEDULER_H_
 
 #include <string>
+#include <pthread.h>
 
 using std::string;
 
+class MessageDecoder;
+
 /*
  * Super class of TaskScheduler
  */
@@ -21,7 +24,13 @@ public:
 	virtual ~Scheduler();
 	virtual void handleMessage(int localListenPort, string fromHost,
 			int msgType, string &msg, int &retValue) = 0;
+	virtual MessageDecoder * createDecoder(int localListenPort, string fromHost,
+			int msgType) = 0; // to decode a message while it is received, NULL if not
+	virtual int reserveHelperThreads(int most); // idle threads for a running task, counted as running
+	virtual void releaseHelperThreads(int num);
 
+	static Scheduler * current(); // scheduler of the task running in this thread, NULL if none
+	static void setCurrent(Scheduler *scheduler);
 };
 
 
@@ -12,6 +12,7 @@
 #include "Partition.h"
 
 #include <vector>
+#include <utility>
 using namespace std;
 
 /*
@@ -20,9 +21,15 @@ using namespace std;
 class ShuffledPartition: public Partition {
 public:
 	ShuffledPartition(long _rddID, int _partitionID);
+	ShuffledPartition(long _rddID, int _partitionID, int _firstPartition, int _lastPartition);
+	ShuffledPartition(long _rddID, int _partitionID, int _hashPartition,
+			vector< pair<int, int> > &_taskRanges);
+	bool hasTask(int task);
 
 	long rddID;
 	int partitionID;
+	int firstPartition, lastPartition; // hash partitions [firstPartition, lastPartition) of map output
+	vector< pair<int, int> > taskRanges; // output of map tasks in these ranges only, all if empty
 };
 
 
@@ -8,7 +8,7 @@
 #ifndef HEADERS_SHUFFLEDRDD_H_
 #define HEADERS_SHUFFLEDRDD_H_
 
-#include "Messaging.h"
+#include "BaseShuffledRDD.h"
 #include "IteratorSeq.h"
 #include "Partition.h"
 #include "RDD.h"
@@ -18,6 +18,13 @@
 #include "HashDivider.h"
 #include "ShuffledPartition.h"
 #include "ShuffledTask.h"
+#include "CombiningTask.h"
+#include "ShuffledSliceTask.h"
+#include "MapStatus.h"
+#include "FlatCombinerMap.h"
+#include "NodeCombiner.h"
+#include "MessageDecoder.h"
+#include "Scheduler.h"
 
 #include <string>
 #include <vector>
@@ -27,13 +34,79 @@
 using namespace std;
 using std::tr1::unordered_map;
 
+int XYZ_SHUFFLE_MERGE_THREADS = 4; // most threads merging a reduce partition, helpers take idle threads of the task scheduler
+long XYZ_SHUFFLE_MERGE_MIN_RECORDS = 100000; // partitions with fewer records are merged by one thread
+
+enum ShuffleMergeUnitType {
+	MERGE_LOCAL_TASK, // output of a map task on this node
+	MERGE_NODE, // output combined on this node
+	MERGE_BLOCK, // serialized combiners, pushed by another node
+	MERGE_FETCH // output on another node
+};
+
+/*
+ * a piece of map output of a reduce partition, to be merged by one thread
+ */
+struct xyz_shuffled_rdd_merge_unit_ {
+	ShuffleMergeUnitType type;
+	int task; // MERGE_LOCAL_TASK: index of the map task
+	string block; // MERGE_BLOCK
+	string host; // MERGE_FETCH: output of map tasks in [firstTask, lastTask), all if firstTask < 0
+	int firstTask, lastTask;
+
+	xyz_shuffled_rdd_merge_unit_(ShuffleMergeUnitType type, int task = -1)
+	: type(type), task(task), firstTask(-1), lastTask(-1) { }
+};
+
+template <class K, class V, class C> class ShuffledRDD;
+
+/*
+ * thread data struct for threads helping to merge a reduce partition.
+ * each thread merges into its own combiners, which are merged at last.
+ */
+template <class K, class V, class C>
+struct xyz_shuffled_rdd_merge_thread_data_ {
+	ShuffledRDD<K, V, C> *rdd;
+	int partitionID;
+	vector<xyz_shuffled_rdd_merge_unit_> *units;
+	size_t *next; // next unit to merge
+	pthread_mutex_t *mutex; // for next
+	FlatCombinerMap<K, C> combiners;
+
+	xyz_shuffled_rdd_merge_thread_data_(ShuffledRDD<K, V, C> *rdd, int partitionID,
+			vector<xyz_shuffled_rdd_merge_unit_> *units, size_t *next, pthread_mutex_t *mutex)
+	: rdd(rdd), partitionID(partitionID), units(units), next(next), mutex(mutex) { }
+};
+
+template <class K, class V, class C>
+void * xyz_shuffled_rdd_merge_thread_f(void *data);
+
+/*
+ * to merge fetched combiners while they are received,
+ * so only the combiners, not the fetched data, are held in memory.
+ */
+template <class K, class V, class C>
+class ShuffleDataDecoder : public RecordDecoder {
+public:
+	ShuffleDataDecoder(ShuffledRDD<K, V, C> *rdd, FlatCombinerMap<K, C> &combiners);
+	int getInvalid();
+
+protected:
+	void record(string &s);
+
+private:
+	ShuffledRDD<K, V, C> *rdd;
+	FlatCombinerMap<K, C> &combiners;
+	int invalid; // records failed to convert
+};
+
 template <class K, class V, class C>
 
 /*
  * ShuffledRDD means partition values of previous RDD will be redistributed in new partitions.
- * PairRDD::combineByKey, PairRDD::reduceByKey, PairRDD::groupByKey will generate ShuffledRDD.
+ * PairRDD::combineByKey, PairRDD::reduceByKey will generate ShuffledRDD.
  */
-class ShuffledRDD : public RDD< Pair<K, C> >, public Messaging
+class ShuffledRDD : public BaseShuffledRDD< K, V, Pair<K, C>, Pair<K, C> >
 {
 public:
 	ShuffledRDD(RDD< Pair<K, V> > *_prevRDD,
@@ -43,27 +116,38 @@ public:
 			string (*strf)(Pair<K, C> &p),
 			Pair<K, C> (*_recoverFunc)(string &s));
 	~ShuffledRDD();
-	vector<Partition*> getPartitions();
 	vector<string> preferredLocations(Partition *p);
 	IteratorSeq< Pair<K, C> > * iteratorSeq(Partition *p);
-	void shuffle();
-	void messageReceived(int localListenPort, string fromHost, int msgType, string &msg);
+	HashDivider * getPartitioner();
+	string combineSlice(int partitionID, int firstTask, int lastTask);
+
+	friend class ShuffleDataDecoder<K, V, C>;
+	template <class K1, class V1, class C1> friend void * xyz_shuffled_rdd_merge_thread_f(void *data);
+
+protected:
+	void beforeMapStage(bool toFile);
+	void afterMapStage();
 
 private:
-	RDD< Pair<K, V> > *prevRDD;
 	Aggregator< Pair<K, V>, Pair<K, C> > agg;
-	HashDivider hd;
 	long (*hashFunc)(Pair<K, C> &p); // function to compute hashCode of a pair
     string (*strFunc)(Pair<K, C> &p); // function  to serialize a pair to string (to save to file)
     Pair<K, C> (*recoverFunc)(string &s); // function to deserialize a string to a pair
-    long shuffleID;
-    bool shuffleFinished;
-	vector< ShuffledTask< Pair<K, V>, Pair<K, C> > * > shuffledTasks;
-    map<int, IteratorSeq< Pair<K, C> >* > shuffleCache; // cache for iteratorSeq()
-    vector<pthread_mutex_t> shuffleMutexes;
+    map<int, vector<string> > slicedPartitions; // partial combiners of split partitions
+    vector<string> reduceHosts; // hosts partitions are pushed to, in push mode
+    bool mapSideCombine; // map tasks are CombiningTasks, by XYZ_SHUFFLE_MAP_SIDE_COMBINE at construction
+    NodeCombiner<K, V, C> *nodeCombiner; // combined output of map tasks on this node, NULL if not used
 
-	void merge(vector<string> &replys, unordered_map<K, C> &combiners); // merge fetched combiners
+	void combine(int partitionID, int firstTask, int lastTask,
+			FlatCombinerMap<K, C> &combiners); // combine output of map tasks in [firstTask, lastTask)
+	void combinePartition(int partitionID, FlatCombinerMap<K, C> &combiners); // combine a hash partition
+	int mergeThreads(int partitionID, int firstTask, int lastTask); // threads to combine a partition, helpers reserved
+	void releaseMergeThreads(int helpers); // helpers reserved by mergeThreads finished
+	void mergeUnits(int partitionID, vector<xyz_shuffled_rdd_merge_unit_> &units,
+			size_t &next, pthread_mutex_t *mutex, FlatCombinerMap<K, C> &combiners); // merge units not taken
+	void mergeUnit(int partitionID, xyz_shuffled_rdd_merge_unit_ &unit, FlatCombinerMap<K, C> &combiners);
+	void merge(vector<string> &replys, FlatCombinerMap<K, C> &combiners); // merge fetched combiners
+	void splitPartitions(); // split skewed or, if adaptive, large partitions
 };
 
-
 #endif /* HEADERS_SHUFFLEDRDD_H_ */
@@ -0,0 +1,43 @@
+/*
+ * ShuffledSliceTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SHUFFLEDSLICETASK_H_
+#define HEADERS_SHUFFLEDSLICETASK_H_
+
+#include <vector>
+#include <string>
+
+#include "Task.h"
+using std::vector;
+using std::string;
+
+template <class K, class V, class C> class ShuffledRDD;
+
+/*
+ * ShuffledRDD::shuffle creates and runs ShuffledSliceTasks for skewed partitions.
+ * A ShuffledSliceTask merges combiners of one partition written by a range of map tasks,
+ * so a skewed partition is merged by several tasks in parallel.
+ * The result is the serialized partial combiners.
+ */
+template <class K, class V, class C>
+class ShuffledSliceTask : public Task<string> {
+public:
+	ShuffledSliceTask(ShuffledRDD<K, V, C> *r, int partitionID,
+			int firstTask, int lastTask, vector<string> &locations);
+	string run();
+	string serialize(string &t);
+	string deserialize(string &s);
+	vector<string> preferredLocations();
+
+private:
+	ShuffledRDD<K, V, C> *rdd;
+	int partitionID;
+	int firstTask, lastTask; // map tasks in [firstTask, lastTask)
+	vector<string> locations; // hosts of the map tasks
+};
+
+
+#endif /* HEADERS_SHUFFLEDSLICETASK_H_ */
@@ -16,18 +16,30 @@
 #include "Partition.h"
 #include "IteratorSeq.h"
 #include "VectorIteratorSeq.h"
+#include "Messaging.h"
+#include "MapStatus.h"
+#include "MemoryGovernor.h"
+#include "MessageDecoder.h"
 
 #include <iostream>
 #include <string>
+#include <pthread.h>
 using namespace std;
 
+int XYZ_SHUFFLE_OUTPUT_MODE = 0; // 0: memory, 1: local file (always file if tasks run by fork)
+string XYZ_SHUFFLE_OUTPUT_DIR = "sunwaymrshuffle/"; // directory of shuffle output files
+int XYZ_SHUFFLE_PUSH_MODE = 0; // 0: reducers pull, 1: map tasks also push partitions to reducer hosts
+
 /*
  * ShuffledRDD::shuffle will create and run ShuffleTasks.
  * ShuffledTask is designed to obtain partition data of ShuffledRDD from previous RDD.
  * Values above will be fetched in ShuffledRDD::iteratorSeq
+ * If output goes to file, the serialized output is written to local files
+ * and mapped back by the process serving fetch requests.
+ * If push targets are set, partitions are also sent to their reduce hosts.
  */
 template <class T, class U>
-class ShuffledTask : public RDDTask< T, int >, public DataCache {
+class ShuffledTask : public RDDTask< T, MapStatus >, public DataCache {
 public:
 	ShuffledTask(RDD<T> *r, Partition *p, long shID, int nPs,
 			HashDivider &hashDivider,
@@ -35,13 +47,29 @@ public:
 			long (*hFunc)(U &u),
 			string (*sf)(U &u));
 	~ShuffledTask();
-	int run();
+	MapStatus run();
 	void getData(long cacheIndex, string &result);
-	IteratorSeq<U> * getPartitionData(int partition);
-	string serialize(int &t);
-	int deserialize(string &s);
+	size_t getDataSize(long cacheIndex);
+	void appendData(long cacheIndex, string &result);
+	void appendData(long cacheIndex, size_t offset, size_t length, string &result);
+	void decodeData(long cacheIndex, MessageDecoder &decoder); // decode output of a partition in place
+	void setOutputToFile(bool toFile);
+	void setPushTargets(Messaging *messenger, vector<string> &hosts, int port);
+	bool hasOutput();
+	size_t memoryUsed();
+	string serialize(MapStatus &t);
+	MapStatus deserialize(string &s);
+
+protected:
+	virtual int choosePartition(U &u); // new partition index of a combiner
+	virtual void addToPartition(int part, U &u); // add a combiner to a new partition
+	virtual void finishPartitions(); // called after all combiners are partitioned
+	void serializePartitions(); // write map output into one contiguous buffer
+	bool writeOutputFiles(); // write output buffer and index to local files
+	bool loadOutputFiles(); // map output files written by a forked task
+	const char * outputData();
+	void pushPartitions(); // send partitions to the hosts of their reduce tasks
 
-private:
 	long shuffleID; // the same as rddID
 	int numPartitions;
 	HashDivider hd;
@@ -49,7 +77,23 @@ private:
 	long (*hashFunc)(U &u);
 	string (*strFunc)(U &u);
 
-    vector< VectorIteratorSeq<U> * > partitions;
+    vector< VectorIteratorSeq<U> * > partitions; // released once serialized
+    MapStatus status; // result of this task
+    string output; // serialized partitions, one after another
+    vector<size_t> outputIndex; // partition i is output[outputIndex[i], outputIndex[i+1])
+
+    bool outputToFile;
+    string outputPath; // path prefix of .data and .index files
+    char *mappedOutput; // mapped .data file, NULL if output is in memory
+    size_t mappedSize;
+    bool outputReady; // output is complete in memory, or loaded from files
+    pthread_mutex_t outputMutex; // for outputReady and loading files
+    size_t usedMemory; // working set when running
+    size_t keptMemory; // acquired from XYZ_MEMORY_GOVERNOR for output kept in memory
+
+    Messaging *pushMessenger; // NULL if not pushing
+    vector<string> pushHosts; // reduce host of each partition
+    int pushPort;
 };
 
 #endif /* HEADERS_SHUFFLEDTASK_H_ */
@@ -0,0 +1,91 @@
+/*
+ * SortedRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SORTEDRDD_H_
+#define HEADERS_SORTEDRDD_H_
+
+#include "BaseShuffledRDD.h"
+#include "IteratorSeq.h"
+#include "VectorIteratorSeq.h"
+#include "Partition.h"
+#include "RDD.h"
+#include "Pair.h"
+#include "SunwayMRContext.h"
+#include "Aggregator.h"
+#include "HashDivider.h"
+#include "RangeDivider.h"
+#include "ShuffledPartition.h"
+#include "SortedTask.h"
+#include "MapStatus.h"
+#include "MessageDecoder.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <pthread.h>
+using namespace std;
+
+template <class K, class V> class SortedRDD;
+
+/*
+ * to deserialize sorted runs while they are decoded,
+ * from output buffers of local map tasks or from fetched data.
+ * a message joins sorted runs of all tasks on a node,
+ * so a new run starts wherever the order of keys breaks, and at each message.
+ */
+template <class K, class V>
+class SortedRunDecoder : public RecordDecoder {
+public:
+	SortedRunDecoder(SortedRDD<K, V> *rdd, vector< vector< Pair<K, V> > > &runs);
+	void finish();
+	int getInvalid();
+
+protected:
+	void record(string &s);
+
+private:
+	SortedRDD<K, V> *rdd;
+	vector< vector< Pair<K, V> > > &runs;
+	bool newRun; // the next pair starts a new run
+	int invalid; // records failed to convert
+};
+
+/*
+ * SortedRDD redistributes pairs of previous RDD into new partitions by key ranges.
+ * Pairs in partition i all have smaller (or greater, if descending) keys than pairs in partition i+1,
+ * and each partition is sorted by key, so the whole RDD is sorted.
+ * PairRDD::sortByKey will generate SortedRDD.
+ */
+template <class K, class V>
+class SortedRDD : public BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, V> >
+{
+public:
+	SortedRDD(RDD< Pair<K, V> > *_prevRDD,
+			int numPartitions,
+			bool ascending,
+			string (*strf)(Pair<K, V> &p),
+			Pair<K, V> (*_recoverFunc)(string &s));
+	IteratorSeq< Pair<K, V> > * iteratorSeq(Partition *p);
+
+	friend class SortedRunDecoder<K, V>;
+
+protected:
+	void beforeMapStage(bool toFile);
+	void afterMapStage();
+
+private:
+	RangeDivider<K> rd;
+	Aggregator< Pair<K, V>, Pair<K, V> > agg;
+	string (*strFunc)(Pair<K, V> &p); // function to serialize a pair to string
+	Pair<K, V> (*recoverFunc)(string &s); // function to deserialize a string to a pair
+	bool prevPersisted; // previous RDD is persisted by this RDD while shuffling
+	bool prevSticky; // whether previous RDD was sticky before
+
+	void sample(); // choose range bounds by sampling keys of previous RDD
+	void mergeRuns(vector< vector< Pair<K, V> > > &runs, VectorIteratorSeq< Pair<K, V> > &result); // k-way merge
+};
+
+#endif /* HEADERS_SORTEDRDD_H_ */
@@ -0,0 +1,36 @@
+/*
+ * SortedTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_SORTEDTASK_H_
+#define HEADERS_SORTEDTASK_H_
+
+#include "ShuffledTask.h"
+#include "RangeDivider.h"
+#include "Pair.h"
+
+/*
+ * SortedRDD::shuffle will create and run SortedTasks.
+ * A SortedTask divides pairs of a partition by key ranges instead of key hashes,
+ * and sorts each new partition by key, so that every map output is a sorted run.
+ */
+template <class K, class V>
+class SortedTask : public ShuffledTask< Pair<K, V>, Pair<K, V> > {
+public:
+	SortedTask(RDD< Pair<K, V> > *r, Partition *p, long shID, int nPs,
+			HashDivider &hashDivider,
+			Aggregator< Pair<K, V>, Pair<K, V> > &aggregator,
+			string (*sf)(Pair<K, V> &p),
+			RangeDivider<K> *rangeDivider);
+
+protected:
+	int choosePartition(Pair<K, V> &p);
+	void finishPartitions();
+
+private:
+	RangeDivider<K> *rd;
+};
+
+#endif /* HEADERS_SORTEDTASK_H_ */
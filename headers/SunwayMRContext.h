@@ -65,7 +65,13 @@ public:
 	int getListenPort();
 	vector<string> getHosts();
 	int getTotalThreads();
+	vector<string> getTaskHosts(int taskNum);
 	void saveShuffleCache(long shuffleID, DataCache *cache);
+	void releaseShuffleCache(long shuffleID);
+	void retainFileCache(string path);
+	void releaseFileCache(string path);
+	void takePushedShuffleData(long shuffleID, int partitionID, map<long, string> &blocks); // task ID -> block
+	void clearPushedShuffleData(long shuffleID);
 
 private:
 	JobScheduler *scheduler;
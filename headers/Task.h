@@ -19,6 +19,15 @@ using std::string;
 #ifndef COLLECT_TASK_DELIMITATION
 #define COLLECT_TASK_DELIMITATION "\aCT\a"
 #endif
+#ifndef SAMPLE_TASK_DELIMITATION
+#define SAMPLE_TASK_DELIMITATION "\aST\a"
+#endif
+#ifndef COUNT_TASK_DELIMITATION
+#define COUNT_TASK_DELIMITATION "\aCNT\a"
+#endif
+#ifndef TOP_TASK_DELIMITATION
+#define TOP_TASK_DELIMITATION "\aTOP\a"
+#endif
 #ifndef TASK_RESULT_DELIMITATION
 #define TASK_RESULT_DELIMITATION "\aTR\a"
 #endif
@@ -50,6 +59,9 @@ public:
 	virtual string serialize(T &t) = 0;
 	virtual T deserialize(string &s) = 0;
 	virtual vector<string> preferredLocations() { return vector<string>(0); }
+	virtual void scheduled(string host) { } // called on all nodes when the task is to run at host
+	virtual size_t memoryUsed() { return 0; } // working set of the task after running, 0 if unknown
+	virtual size_t memoryExpected() { return 0; } // working set of the task before running, 0 if unknown
 
 	long taskID;
 };
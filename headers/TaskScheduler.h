@@ -14,9 +14,31 @@
 #include "Scheduler.h"
 #include "Task.h"
 #include "TaskResult.h"
+#include "MemoryGovernor.h"
 
 int XYZ_TASK_SCHEDULER_RUN_TASK_MODE = 1; // 0: fork, 1: pthread
 
+template <class T> class TaskScheduler;
+
+/*
+ * to decode a task result list from master while it is received,
+ * each task result is saved as soon as it arrives.
+ */
+template <class T>
+class TaskResultListDecoder : public RecordDecoder {
+public:
+	TaskResultListDecoder(TaskScheduler<T> *ts);
+	void finish();
+
+protected:
+	void record(string &s);
+
+private:
+	TaskScheduler<T> *taskScheduler;
+	int count; // task results decoded
+	bool valid;
+};
+
 /*
  * TaskScheduler will run tasks of one job.
  * When running, each node will run one or more of given tasks.
@@ -38,8 +60,16 @@ public:
 	void handleMessage(int localListenPort, string fromHost, int msgType, string &msg, int &retValue); // override Scheduler
 	void increaseRunningThreadNum();
 	void decreaseRunningThreadNum();
+	int reserveHelperThreads(int most); // override Scheduler
+	void releaseHelperThreads(int num); // override Scheduler
+	size_t estimateTaskMemory(int task);
+	void releaseTaskMemory(int task, size_t resultSize);
 	bool getTaskResultString(int job, int task, string &result);
-	bool getTaskResultListString(int job, string &result);
+	bool writeTaskResultList(int job, ChunkedWriter &writer);
+	void skipTaskResultList(int job);
+	MessageDecoder * createDecoder(int localListenPort, string fromHost, int msgType); // override Messaging and Scheduler
+	bool receiveTaskResult(string &result); // save a task result of the list from master
+	void finishTaskResultList(int count, bool valid);
 
 private:
 	int jobID;
@@ -52,7 +82,8 @@ private:
 	vector<string> taskOnIPVector;
 	int isMaster;
 
-	volatile int runningThreadNum;
+	volatile int runningThreadNum; // task threads and reserved helper threads
+	int waitingTaskNum; // tasks to run on this node, not launched yet
 	vector<pthread_t> startedThreads;
 	vector<bool> resultReceived;
 	volatile int receivedTaskResultNum;
@@ -60,10 +91,23 @@ private:
     bool taskResultListSent;
 	vector< Task<T>* > tasks;
     vector< TaskResult<T>* > taskResults;
+    vector<size_t> taskMemory; // reserved from XYZ_MEMORY_GOVERNOR by running tasks
+    size_t memoryPerTask; // most memory used by a finished task of this job on this node
+    long memoryReleasedNum; // tasks which have released their memory
 
     pthread_mutex_t mutex_handle_message_ready;
     pthread_mutex_t mutex_all_tasks_received;
     pthread_mutex_t mutex_task_scheduler;
+    pthread_cond_t cond_task_memory; // signaled when a running task releases memory
+
+    // serialized task results, shared by the threads sending the task result list to nodes
+    vector<string> resultStrings;
+    vector<int> resultStringStates; // 0 not serialized, 1 being serialized, 2 serialized
+    vector<int> resultStringTakers; // senders which have not taken the string yet
+    pthread_mutex_t mutex_result_strings;
+    pthread_cond_t cond_result_strings; // signaled when a task result is serialized
+
+    void takeTaskResultString(int task, string *result); // serialized once for all senders, skipped if NULL
 };
 
 
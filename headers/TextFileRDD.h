@@ -32,15 +32,18 @@ class TextFileRDD : public RDD<TextFileBlock> {
 public:
 	TextFileRDD(SunwayMRContext *c, vector<FileSource> &files, int numSlices,
 			FileSourceFormat format = FILE_SOURCE_FORMAT_BYTE);
+	~TextFileRDD();
 	vector<Partition*> getPartitions();
 	vector<string> preferredLocations(Partition *p);
 	IteratorSeq<TextFileBlock> * iteratorSeq(Partition *p);
+	size_t inputBytes(Partition *p);
 	vector< IteratorSeq<TextFileBlock>* > slice(vector<FileSource> &files);
 
 	//data
 	int numSlices;
 	FileSourceFormat format;
 	long textFileRDD_id;
+	vector<string> filePaths; // files kept in cache while this RDD lives
 
 };
 
@@ -0,0 +1,51 @@
+/*
+ * TopTask.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_TOPTASK_H_
+#define HEADERS_TOPTASK_H_
+
+#include <vector>
+
+#include "RDDTask.h"
+using std::vector;
+
+/*
+ * order of values in the result of RDD::top and RDD::takeOrdered.
+ * takeOrdered: ascending by less, top: descending by less.
+ */
+template <class T>
+struct xyz_top_task_order_ {
+	bool (*less)(T&, T&);
+	bool largest;
+
+	xyz_top_task_order_(bool (*less)(T&, T&), bool largest)
+	: less(less), largest(largest) { }
+
+	bool operator()(T &a, T &b) { // a comes before b
+		return largest ? less(b, a) : less(a, b);
+	}
+};
+
+/*
+ * RDD::top and RDD::takeOrdered create and run TopTasks.
+ * The first k values of a partition in order are kept in a bounded heap,
+ * so only k values are sent back, in order.
+ */
+template <class T>
+class TopTask : public RDDTask< T, vector<T> > {
+public:
+	TopTask(RDD<T> *r, Partition *p, long k, bool (*less)(T&, T&), bool largest);
+	vector<T> run();
+	string serialize(vector<T> &t);
+	vector<T> deserialize(string &s);
+
+private:
+	long k;
+	xyz_top_task_order_<T> order;
+};
+
+
+#endif /* HEADERS_TOPTASK_H_ */
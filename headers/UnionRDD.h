@@ -33,6 +33,7 @@ public:
 	~UnionRDD();
 	vector<Partition*> getPartitions();
 	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
 	IteratorSeq<T> * iteratorSeq(Partition *p);
 	void shuffle();
 
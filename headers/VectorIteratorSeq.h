@@ -25,6 +25,8 @@ public:
 	void push_back(T t);
 	void push_back(vector<T> &v);
 	void reserve(size_t size);
+	void sort(bool (*cmp)(const T&, const T&));
+	void swap(vector<T> &other);
 	int getType() const;
 	size_t size() const;
 	T at(size_t index) const;
@@ -0,0 +1,35 @@
+/*
+ * XoshiroRandom.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_XOSHIRORANDOM_H_
+#define HEADERS_XOSHIRORANDOM_H_
+
+#include <stdint.h>
+
+/*
+ * A fast pseudo random generator (xoshiro256**), with no shared state.
+ * Unlike rand(), it takes no lock, so each task thread can own one.
+ * Generators of the same seed and stream (e.g. a partition index)
+ * produce the same numbers on every node and every run,
+ * and different streams are independent.
+ */
+class XoshiroRandom {
+public:
+	XoshiroRandom(uint64_t seed);
+	XoshiroRandom(uint64_t seed, long stream);
+	uint64_t next();
+	double nextDouble(); // in [0, 1)
+	long nextLong(long n); // in [0, n)
+	long nextPoisson(double mean);
+
+private:
+	uint64_t s[4];
+
+	void setSeed(uint64_t seed);
+};
+
+
+#endif /* HEADERS_XOSHIRORANDOM_H_ */
@@ -0,0 +1,48 @@
+/*
+ * ZippedJoinRDD.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_ZIPPEDJOINRDD_H_
+#define HEADERS_ZIPPEDJOINRDD_H_
+
+#include <vector>
+#include <string>
+
+#include "IteratorSeq.h"
+#include "Partition.h"
+#include "ZippedPartition.h"
+#include "RDD.h"
+#include "Pair.h"
+#include "HashDivider.h"
+using std::vector;
+using std::string;
+
+template <class T> class RDD;
+
+/*
+ * ZippedJoinRDD joins two RDDs partitioned by the same HashDivider.
+ * Pairs with the same key are in partitions with the same index,
+ * so partition i is joined from partition i of both RDDs, without shuffle.
+ * PairRDD::join will generate ZippedJoinRDD if both RDDs are co-partitioned.
+ */
+template <class K, class V, class W>
+class ZippedJoinRDD : public RDD< Pair< K, Pair<V, W> > > {
+public:
+	ZippedJoinRDD(RDD< Pair<K, V> > *left, RDD< Pair<K, W> > *right);
+	~ZippedJoinRDD();
+	vector<Partition *> getPartitions();
+	vector<string> preferredLocations(Partition *p);
+	void partitionScheduled(Partition *p, string host);
+	IteratorSeq< Pair< K, Pair<V, W> > > * iteratorSeq(Partition *p);
+	void shuffle();
+	HashDivider * getPartitioner();
+
+private:
+	RDD< Pair<K, V> > *leftRDD;
+	RDD< Pair<K, W> > *rightRDD;
+};
+
+
+#endif /* HEADERS_ZIPPEDJOINRDD_H_ */
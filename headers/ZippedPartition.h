@@ -0,0 +1,26 @@
+/*
+ * ZippedPartition.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef HEADERS_ZIPPEDPARTITION_H_
+#define HEADERS_ZIPPEDPARTITION_H_
+
+#include "Partition.h"
+
+/*
+ * Partition of ZippedJoinRDD.
+ * Constructed from partitions with the same index of two co-partitioned RDDs.
+ */
+class ZippedPartition: public Partition {
+public:
+	ZippedPartition(long rddID, int partitionID, Partition *left, Partition *right);
+
+	long rddID;
+	int partitionID;
+	Partition *left;
+	Partition *right;
+};
+
+#endif /* HEADERS_ZIPPEDPARTITION_H_ */
@@ -0,0 +1,96 @@
+/*
+ * AggregateTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_AGGREGATETASK_HPP_
+#define INCLUDE_AGGREGATETASK_HPP_
+
+#include "AggregateTask.h"
+
+#include "IteratorSeq.hpp"
+#include "RDDTask.hpp"
+#include "StringConversion.hpp"
+
+/*
+ * constructor, to aggregate a partition
+ */
+template <class T, class U>
+AggregateTask<T, U>::AggregateTask(RDD<T> *r, Partition *p, U &zero,
+		U (*seqOp)(U&, T&), U (*combOp)(U&, U&))
+:RDDTask<T, U>::RDDTask(r, p), group(1, p), zero(zero), seqOp(seqOp), combOp(combOp)
+{
+}
+
+/*
+ * constructor, to aggregate a group of partitions
+ */
+template <class T, class U>
+AggregateTask<T, U>::AggregateTask(RDD<T> *r, vector<Partition*> &group, U &zero,
+		U (*seqOp)(U&, T&), U (*combOp)(U&, U&))
+:RDDTask<T, U>::RDDTask(r, group[0]), group(group), zero(zero), seqOp(seqOp), combOp(combOp)
+{
+}
+
+/*
+ * to fold values of each partition, and merge the results of partitions
+ */
+template <class T, class U>
+U AggregateTask<T, U>::run() {
+	U ret = zero;
+	for (unsigned int i = 0; i < group.size(); i++) {
+		IteratorSeq<T> *seq = RDDTask<T, U>::rdd->getOrCompute(group[i]);
+		U u = zero;
+		size_t n = seq->size();
+		for (size_t j = 0; j < n; j++) {
+			T t = seq->at(j);
+			u = seqOp(u, t);
+		}
+
+		if (i == 0) {
+			ret = u;
+		} else {
+			ret = combOp(ret, u);
+		}
+	}
+	return ret;
+}
+
+/*
+ * to serialize the task result
+ */
+template <class T, class U>
+string AggregateTask<T, U>::serialize(U &t) {
+	return to_string(t);
+}
+
+/*
+ * to deserialize a string to task result
+ */
+template <class T, class U>
+U AggregateTask<T, U>::deserialize(string &s) {
+	U t = zero;
+	from_string(t, s);
+	return t;
+}
+
+/*
+ * partitions of a group prefer the same hosts, those of the first one.
+ */
+template <class T, class U>
+vector<string> AggregateTask<T, U>::preferredLocations() {
+	return RDDTask<T, U>::rdd->getPreferredLocations(group[0]);
+}
+
+/*
+ * all partitions of the group are computed at host.
+ */
+template <class T, class U>
+void AggregateTask<T, U>::scheduled(string host) {
+	for (unsigned int i = 0; i < group.size(); i++) {
+		RDDTask<T, U>::rdd->partitionScheduled(group[i], host);
+	}
+}
+
+#endif /* INCLUDE_AGGREGATETASK_HPP_ */
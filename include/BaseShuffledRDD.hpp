@@ -0,0 +1,350 @@
+/*
+ * BaseShuffledRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_BASESHUFFLEDRDD_HPP_
+#define INCLUDE_BASESHUFFLEDRDD_HPP_
+
+#include "BaseShuffledRDD.h"
+
+#include <map>
+#include <sstream>
+#include <algorithm>
+
+#include "IteratorSeq.hpp"
+#include "Partition.hpp"
+#include "ShuffledPartition.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "SunwayMRContext.hpp"
+#include "ShuffledTask.hpp"
+#include "MapStatus.hpp"
+#include "HashDivider.hpp"
+#include "TaskResult.hpp"
+#include "Task.hpp"
+#include "Messaging.hpp"
+#include "Logging.hpp"
+#include "TaskScheduler.hpp"
+#include "VectorAutoPointer.hpp"
+
+using namespace std;
+
+/*
+ * constructor.
+ * to generate new partitions, one for each hash partition, and initialize their mutexes.
+ */
+template <class K, class V, class U, class T>
+BaseShuffledRDD<K, V, U, T>::BaseShuffledRDD(RDD< Pair<K, V> > *_prevRDD,
+		const HashDivider &_hd, string _name)
+: RDD<T>::RDD(_prevRDD->context), prevRDD(_prevRDD), hd(_hd), name(_name)
+{
+	shuffleID = this->rddID;
+	shuffleFinished = false;
+	adaptive = false;
+
+	vector<Partition*> parts;
+	this->shuffleMutexes.reserve(hd.getNumPartitions());
+	for(int i = 0; i < hd.getNumPartitions(); i++)
+	{
+		Partition *part = new ShuffledPartition(this->rddID, i);
+		parts.push_back(part);
+
+		this->shuffleMutexes.push_back(pthread_mutex_t());
+		pthread_mutex_init(&this->shuffleMutexes.back(), NULL);
+	}
+	this->partitions = parts;
+}
+
+/*
+ * destructor.
+ * deleting all the shuffle tasks and iteratorSeq cache.
+ * deleting the previous RDD if that is not sticky.
+ */
+template <class K, class V, class U, class T>
+BaseShuffledRDD<K, V, U, T>::~BaseShuffledRDD()
+{
+	this->context->releaseShuffleCache(this->shuffleID); // stop serving before deleting tasks
+	for(size_t i = 0; i < this->shuffledTasks.size(); i++) {
+		delete this->shuffledTasks[i];
+	}
+	this->shuffledTasks.clear();
+
+	typename std::map<int, IteratorSeq<T>* >::iterator it;
+	for (it=this->shuffleCache.begin(); it!=this->shuffleCache.end(); ++it) {
+		delete (it->second);
+	}
+	this->shuffleCache.clear();
+
+	// partitions not split are kept after the map stage, deleted with the others by RDD
+	for(size_t i = 0; i < this->hashPartitions.size(); i++) {
+		if(find(this->partitions.begin(), this->partitions.end(), this->hashPartitions[i]) == this->partitions.end()) {
+			delete this->hashPartitions[i];
+		}
+	}
+	this->hashPartitions.clear();
+
+	for(size_t i = 0; i < this->shuffleMutexes.size(); i++) {
+		pthread_mutex_destroy(&this->shuffleMutexes[i]);
+	}
+
+	if(this->prevRDD != NULL && !this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * to get partitions of this RDD.
+ * the partitions stored in itself, no its previous RDD.
+ */
+template <class K, class V, class U, class T>
+vector<Partition*> BaseShuffledRDD<K, V, U, T>::getPartitions()
+{
+	return this->partitions;
+}
+
+/*
+ * to get the preferred locations of a partition,
+ * the hosts holding the largest shares of its map output, by map statuses
+ */
+template <class K, class V, class U, class T>
+vector<string> BaseShuffledRDD<K, V, U, T>::preferredLocations(Partition *p)
+{
+	vector<string> ve;
+	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
+	if(srp == NULL || !shuffleFinished) return ve;
+
+	return MapStatus::preferredHosts(mapStatuses, srp->firstPartition, srp->lastPartition, srp->taskRanges);
+}
+
+/*
+ * to get bytes of map output fetched to build a partition, by map statuses
+ */
+template <class K, class V, class U, class T>
+size_t BaseShuffledRDD<K, V, U, T>::inputBytes(Partition *p)
+{
+	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
+	if(srp == NULL || !shuffleFinished) return 0;
+
+	size_t bytes = 0;
+	for(size_t i = 0; i < mapStatuses.size(); i++) {
+		if(!srp->hasTask(i)) continue;
+		for(int j = srp->firstPartition; j < srp->lastPartition && j < (int)mapStatuses[i].bytes.size(); j++) {
+			bytes += mapStatuses[i].bytes[j];
+		}
+	}
+	return bytes;
+}
+
+/*
+ * shuffle the data set of previous RDD.
+ * to run the map tasks on previous RDD's partitions.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::shuffle()
+{
+	if (shuffleFinished) return; // shuffle was done before
+
+	prevRDD->shuffle(); // firstly, the previous RDD must do the shuffle
+
+	// cache tasks before running them.
+	// other nodes may fetch as soon as the master finishes this job.
+	// output of forked tasks must be written to files to outlive the child process.
+	bool toFile = XYZ_SHUFFLE_OUTPUT_MODE == 1 || XYZ_TASK_SCHEDULER_RUN_TASK_MODE == 0;
+	for(unsigned int i = 0; i < shuffledTasks.size(); i++) {
+		shuffledTasks[i]->setOutputToFile(toFile);
+		this->context->saveShuffleCache(this->shuffleID, shuffledTasks[i]);
+	}
+	this->beforeMapStage(toFile);
+
+	// run tasks via context
+	vector< Task<MapStatus> *> tasks;
+	for(unsigned int i = 0; i < shuffledTasks.size(); i++) {
+		tasks.push_back(shuffledTasks[i]);
+	}
+	vector< TaskResult<MapStatus>* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult<MapStatus> > auto_ptr2(results); // delete pointers automatically
+	for(unsigned int i = 0; i < results.size(); i++) {
+		mapStatuses.push_back(results[i]->value);
+	}
+	this->retryFailedTasks();
+	this->afterMapStage();
+
+	this->shuffleFinished = true;
+
+	// !!! as long as shuffle is done, the previous RDD can be destroyed
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+		this->prevRDD = NULL;
+	}
+}
+
+/*
+ * to run map tasks again whose output was lost, such as forked tasks failing to write files.
+ * map statuses are the same on all nodes, so all nodes run the same jobs.
+ * the application stops if output is still lost after XYZ_SHUFFLE_TASK_RETRIES,
+ * rather than reduce tasks building partitions without it.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::retryFailedTasks()
+{
+	for(int retry = 0; ; retry++) {
+		vector<int> failed;
+		vector< Task<MapStatus> *> tasks;
+		for(unsigned int i = 0; i < mapStatuses.size(); i++) {
+			if(mapStatuses[i].failed) {
+				failed.push_back(i);
+				tasks.push_back(shuffledTasks[i]);
+			}
+		}
+		if(failed.size() == 0) return;
+
+		stringstream ss;
+		ss << name << ": [" << failed.size() << "] map tasks of shuffle [" << shuffleID
+				<< "] lost their output";
+		if(retry >= XYZ_SHUFFLE_TASK_RETRIES) {
+			Logging::logError(ss.str() + ", stopped");
+			exit(105);
+		}
+		Logging::logWarning(ss.str() + ", running them again");
+
+		vector< TaskResult<MapStatus>* > results = this->context->runTasks(tasks);
+		VectorAutoPointer< TaskResult<MapStatus> > auto_ptr(results); // delete pointers automatically
+		for(unsigned int i = 0; i < results.size(); i++) {
+			mapStatuses[failed[i]] = results[i]->value;
+		}
+	}
+}
+
+/*
+ * called when map tasks are cached to be served, before they run.
+ * sub-classes may set up the map tasks or run jobs on the previous RDD.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::beforeMapStage(bool toFile)
+{
+}
+
+/*
+ * called when map tasks have run and map statuses are known.
+ * to coalesce small partitions, if adaptive.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::afterMapStage()
+{
+	if(adaptive) {
+		this->coalescePartitions();
+	}
+}
+
+/*
+ * whether to coalesce small partitions after the map stage,
+ * and split large ones where sub-classes can.
+ * must be set before shuffle.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::setAdaptive(bool a)
+{
+	adaptive = a;
+}
+
+/*
+ * to get the cached data of a partition.
+ * if not cached, NULL is returned with the mutex of the partition held,
+ * the caller builds the data and passes it to unlockPartition.
+ * partitions are cached by ID, so slices of a hash partition are built concurrently.
+ */
+template <class K, class V, class U, class T>
+IteratorSeq<T> * BaseShuffledRDD<K, V, U, T>::lockPartition(ShuffledPartition *srp)
+{
+	pthread_mutex_lock(&this->shuffleMutexes[srp->partitionID]);
+	typename std::map<int, IteratorSeq<T>* >::iterator it = shuffleCache.find(srp->partitionID);
+	if (it == shuffleCache.end()) {
+		return NULL;
+	}
+	pthread_mutex_unlock(&this->shuffleMutexes[srp->partitionID]);
+	return it->second;
+}
+
+/*
+ * to cache the data of a partition built after lockPartition, and release its mutex
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::unlockPartition(ShuffledPartition *srp, IteratorSeq<T> *seq)
+{
+	this->shuffleCache[srp->partitionID] = seq;
+	pthread_mutex_unlock(&this->shuffleMutexes[srp->partitionID]);
+}
+
+/*
+ * to coalesce adjacent small partitions by sizes in map statuses.
+ * partitions before coalescing are kept, RDDs created before shuffle may still refer to them.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::coalescePartitions()
+{
+	vector<int> starts;
+	MapStatus::coalescePartitions(mapStatuses, this->context->getTotalThreads(), starts);
+	int numPartitions = hd.getNumPartitions();
+	if(starts.size() == 0 || (int)starts.size() == numPartitions) return;
+
+	vector<Partition*> parts;
+	for(size_t i = 0; i < starts.size(); i++) {
+		int last = i + 1 < starts.size() ? starts[i + 1] : numPartitions;
+		parts.push_back(new ShuffledPartition(this->rddID, numPartitions + i, starts[i], last));
+	}
+	this->replacePartitions(parts);
+
+	stringstream ss;
+	ss << name << ": [" << numPartitions << "] partitions of shuffle [" << shuffleID
+			<< "] are coalesced into [" << parts.size() << "]";
+	Logging::logInfo(ss.str());
+}
+
+/*
+ * to replace partitions after the map stage, by coalesced or split ones.
+ * partitions before the map stage are kept, RDDs created before shuffle may still refer to them,
+ * partitions replaced during the map stage are deleted.
+ * mutexes are added for new partition IDs, no partition is being built yet.
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::replacePartitions(vector<Partition*> &parts)
+{
+	if(hashPartitions.size() == 0) {
+		hashPartitions = this->partitions;
+	}
+	else {
+		for(size_t i = 0; i < this->partitions.size(); i++) {
+			if(find(parts.begin(), parts.end(), this->partitions[i]) == parts.end()) {
+				delete this->partitions[i];
+			}
+		}
+	}
+	this->partitions = parts;
+
+	size_t ids = shuffleMutexes.size();
+	for(size_t i = 0; i < parts.size(); i++) {
+		ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(parts[i]);
+		if(srp != NULL && srp->partitionID >= (int)ids) ids = srp->partitionID + 1;
+	}
+	if(ids > shuffleMutexes.size()) {
+		for(size_t i = 0; i < shuffleMutexes.size(); i++) {
+			pthread_mutex_destroy(&shuffleMutexes[i]);
+		}
+		shuffleMutexes.assign(ids, pthread_mutex_t());
+		for(size_t i = 0; i < shuffleMutexes.size(); i++) {
+			pthread_mutex_init(&shuffleMutexes[i], NULL);
+		}
+	}
+}
+
+/*
+ * for sub-class of Messaging, must override messageReceived
+ */
+template <class K, class V, class U, class T>
+void BaseShuffledRDD<K, V, U, T>::messageReceived(int localListenPort, string fromHost, int msgType, string &msg)
+{
+}
+
+#endif /* INCLUDE_BASESHUFFLEDRDD_HPP_ */
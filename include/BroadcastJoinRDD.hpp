@@ -0,0 +1,135 @@
+/*
+ * BroadcastJoinRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_BROADCASTJOINRDD_HPP_
+#define INCLUDE_BROADCASTJOINRDD_HPP_
+
+#include "BroadcastJoinRDD.h"
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "Utils.hpp"
+using namespace std;
+
+/*
+ * constructor
+ */
+template <class K, class V, class W>
+BroadcastJoinRDD<K, V, W>::BroadcastJoinRDD(RDD< Pair<K, V> > *prev, RDD< Pair<K, W> > *small)
+:RDD< Pair< K, Pair<V, W> > >::RDD(prev->context), prevRDD(prev), smallRDD(small)
+{
+	broadcastFinished = false;
+}
+
+/*
+ * destructor, deleting the previous RDDs if they are not sticky
+ */
+template <class K, class V, class W>
+BroadcastJoinRDD<K, V, W>::~BroadcastJoinRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+	if(this->smallRDD != NULL && !this->smallRDD->isSticky()) {
+		delete this->smallRDD;
+	}
+}
+
+/*
+ * do shuffling of the large RDD, and broadcast the small RDD.
+ * collect() delivers all pairs of the small RDD to every node,
+ * each node builds the same hash table from them.
+ */
+template <class K, class V, class W>
+void BroadcastJoinRDD<K, V, W>::shuffle()
+{
+	prevRDD->shuffle();
+
+	if (broadcastFinished) return; // broadcast was done before
+
+	vector< Pair<K, W> > pairs = smallRDD->collect();
+	for (size_t i = 0; i < pairs.size(); i++) {
+		table[pairs[i].v1].push_back(pairs[i].v2);
+	}
+	broadcastFinished = true;
+
+	// !!! as long as the table is built, the small RDD can be destroyed
+	if(!this->smallRDD->isSticky()) {
+		delete this->smallRDD;
+		this->smallRDD = NULL;
+	}
+}
+
+/*
+ * keys are kept, so is the partitioner of the large RDD
+ */
+template <class K, class V, class W>
+HashDivider * BroadcastJoinRDD<K, V, W>::getPartitioner()
+{
+	return prevRDD->getPartitioner();
+}
+
+/*
+ * get partitions of the RDD.
+ * as to BroadcastJoinRDD, partitions are from the large RDD.
+ */
+template <class K, class V, class W>
+vector<Partition *> BroadcastJoinRDD<K, V, W>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get preferred locations for the partition.
+ * as to BroadcastJoinRDD, the partition is from the large RDD.
+ */
+template <class K, class V, class W>
+vector<string> BroadcastJoinRDD<K, V, W>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class K, class V, class W>
+void BroadcastJoinRDD<K, V, W>::partitionScheduled(Partition *p, string host)
+{
+	RDD< Pair<K, Pair<V, W> > >::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * get the data set in the partition.
+ * each pair of the large RDD is joined with values of the same key in the table.
+ */
+template <class K, class V, class W>
+IteratorSeq< Pair< K, Pair<V, W> > > * BroadcastJoinRDD<K, V, W>::iteratorSeq(Partition *p)
+{
+	IteratorSeq< Pair<K, V> > *seq = prevRDD->getOrCompute(p);
+	VectorIteratorSeq< Pair< K, Pair<V, W> > > *ret = new VectorIteratorSeq< Pair< K, Pair<V, W> > >();
+
+	typename unordered_map< K, vector<W> >::iterator it;
+	size_t n = seq->size();
+	for (size_t i = 0; i < n; i++) {
+		Pair<K, V> pl = seq->at(i);
+		it = table.find(pl.v1);
+		if (it == table.end()) continue;
+		for (size_t j = 0; j < it->second.size(); j++) {
+			Pair<V, W> right(pl.v2, it->second[j]);
+			ret->push_back(Pair< K, Pair<V, W> >(pl.v1, right));
+		}
+	}
+
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+
+#endif /* INCLUDE_BROADCASTJOINRDD_HPP_ */
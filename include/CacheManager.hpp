@@ -0,0 +1,343 @@
+/*
+ * CacheManager.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_CACHEMANAGER_HPP_
+#define INCLUDE_CACHEMANAGER_HPP_
+
+#include "CacheManager.h"
+
+#include <sstream>
+#include <sys/stat.h>
+
+#include "Utils.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+/*
+ * constructor
+ */
+CacheManager::CacheManager()
+: fileBytes(0), clock(0) {
+	pthread_mutex_init(&mutex_files, NULL);
+	pthread_mutex_init(&mutex_shuffles, NULL);
+	pthread_cond_init(&cond_shuffle_readers, NULL);
+}
+
+/*
+ * destructor
+ */
+CacheManager::~CacheManager() {
+	clearFiles();
+	clearShuffles();
+	pthread_mutex_destroy(&mutex_files);
+	pthread_mutex_destroy(&mutex_shuffles);
+	pthread_cond_destroy(&cond_shuffle_readers);
+}
+
+/*
+ * an RDD starts reading a file
+ */
+void CacheManager::retainFile(string path) {
+	pthread_mutex_lock(&mutex_files);
+	xyz_cache_file_entry_ &entry = findFile(path)->second;
+	entry.refs++;
+	entry.dropped = false;
+	pthread_mutex_unlock(&mutex_files);
+}
+
+/*
+ * an RDD stops reading a file.
+ * the file is dropped if no RDD reads it, after requests reading it.
+ */
+void CacheManager::releaseFile(string path) {
+	pthread_mutex_lock(&mutex_files);
+	map<string, xyz_cache_file_entry_>::iterator it = files.find(path);
+	if (it != files.end()) {
+		it->second.refs--;
+		if (it->second.refs <= 0) {
+			if (it->second.inUse()) {
+				it->second.dropped = true;
+			} else {
+				eraseFile(it);
+			}
+		}
+	}
+	pthread_mutex_unlock(&mutex_files);
+}
+
+/*
+ * to read bytes [offset, offset + length) of a file.
+ * copied without mutex_files held, the entry is pinned meanwhile.
+ */
+void CacheManager::readFileBytes(string path, long offset, long length, string &ret) {
+	string *content = acquireFile(path, false).bytes;
+	if (offset >= 0 && (size_t)offset < content->size()) {
+		ret = content->substr(offset, length);
+	}
+	releaseFileReader(path);
+}
+
+/*
+ * to read lines [offset, offset + length) of a file.
+ * copied without mutex_files held, the entry is pinned meanwhile.
+ */
+void CacheManager::readFileLines(string path, long offset, long length, string &ret) {
+	vector<string> *content = acquireFile(path, true).lines;
+	for (long i = offset; i >= 0 && i < offset + length && (size_t)i < content->size(); i++) {
+		ret += (*content)[i];
+		ret += "\n";
+	}
+	releaseFileReader(path);
+}
+
+/*
+ * drop all cached files.
+ * files being read are dropped after the requests reading them.
+ */
+void CacheManager::clearFiles() {
+	pthread_mutex_lock(&mutex_files);
+	map<string, xyz_cache_file_entry_>::iterator it = files.begin();
+	while (it != files.end()) {
+		map<string, xyz_cache_file_entry_>::iterator next = it;
+		++next;
+		if (it->second.inUse()) {
+			it->second.dropped = true;
+		} else {
+			eraseFile(it);
+		}
+		it = next;
+	}
+	pthread_mutex_unlock(&mutex_files);
+}
+
+/*
+ * to find the entry of a file, created if not cached.
+ * mutex_files must be held.
+ */
+map<string, xyz_cache_file_entry_>::iterator CacheManager::findFile(string path) {
+	map<string, xyz_cache_file_entry_>::iterator it = files.find(path);
+	if (it == files.end()) {
+		it = files.insert(make_pair(path, xyz_cache_file_entry_())).first;
+		it->second.cond = new pthread_cond_t;
+		pthread_cond_init(it->second.cond, NULL);
+	}
+	return it;
+}
+
+/*
+ * to get content of a file, reading it if not cached,
+ * or if the file has been modified since it was read.
+ * only one request reads a file from disk, without mutex_files held,
+ * others requesting it wait on the condition of its entry.
+ * the entry is pinned until releaseFileReader, so its content is not freed while copied.
+ */
+xyz_cache_file_entry_ & CacheManager::acquireFile(string path, bool byLine) {
+	struct stat st;
+	bool known = stat(path.c_str(), &st) == 0;
+
+	pthread_mutex_lock(&mutex_files);
+	xyz_cache_file_entry_ &entry = findFile(path)->second;
+	entry.lastUsed = ++clock;
+	while (true) {
+		bool modified = known && (entry.bytes != NULL || entry.lines != NULL)
+				&& (st.st_mtime != entry.mtime || (long)st.st_size != entry.fileSize);
+		// wait for the request loading it, or for requests copying content read before it was modified
+		if (entry.loading || (modified && entry.readers > 0)) {
+			entry.waiters++;
+			pthread_cond_wait(entry.cond, &mutex_files);
+			entry.waiters--;
+			continue;
+		}
+		if (!modified) break;
+		Logging::logDebug("CacheManager: file [" + path + "] modified, read again");
+		freeFile(entry);
+	}
+
+	if ((byLine && entry.lines == NULL) || (!byLine && entry.bytes == NULL)) {
+		entry.loading = true;
+		if (known) {
+			entry.mtime = st.st_mtime;
+			entry.fileSize = st.st_size;
+		}
+		pthread_mutex_unlock(&mutex_files);
+
+		string *bytes = NULL;
+		vector<string> *lines = NULL;
+		long size = 0;
+		if (byLine) {
+			lines = new vector<string>();
+			readFileToLines(path, *lines);
+			for (size_t i = 0; i < lines->size(); i++) {
+				size += (*lines)[i].size();
+			}
+		} else {
+			bytes = new string();
+			readFile(path, *bytes);
+			size = bytes->size();
+		}
+
+		pthread_mutex_lock(&mutex_files);
+		if (byLine) entry.lines = lines;
+		else entry.bytes = bytes;
+		entry.size += size;
+		fileBytes += size;
+		entry.loading = false;
+		pthread_cond_broadcast(entry.cond);
+		evictFiles(path);
+
+		stringstream ss;
+		ss << "CacheManager: file [" << path << "] cached by " << (byLine ? "line" : "byte")
+				<< ", " << size << " bytes";
+		Logging::logDebug(ss.str());
+	}
+	entry.readers++;
+	pthread_mutex_unlock(&mutex_files);
+	return entry;
+}
+
+/*
+ * a request has copied content of a file acquired by acquireFile
+ */
+void CacheManager::releaseFileReader(string path) {
+	pthread_mutex_lock(&mutex_files);
+	map<string, xyz_cache_file_entry_>::iterator it = files.find(path);
+	if (it != files.end()) {
+		it->second.readers--;
+		if (it->second.readers <= 0) {
+			if (it->second.dropped && !it->second.inUse()) {
+				eraseFile(it);
+			} else {
+				pthread_cond_broadcast(it->second.cond);
+			}
+		}
+	}
+	pthread_mutex_unlock(&mutex_files);
+}
+
+/*
+ * to free content of a cached file, the entry itself is kept.
+ * mutex_files must be held.
+ */
+void CacheManager::freeFile(xyz_cache_file_entry_ &entry) {
+	if (entry.bytes != NULL) {
+		delete entry.bytes;
+		entry.bytes = NULL;
+	}
+	if (entry.lines != NULL) {
+		delete entry.lines;
+		entry.lines = NULL;
+	}
+	fileBytes -= entry.size;
+	entry.size = 0;
+}
+
+/*
+ * to free content of a cached file and remove its entry, which must not be pinned.
+ * mutex_files must be held.
+ */
+void CacheManager::eraseFile(map<string, xyz_cache_file_entry_>::iterator it) {
+	freeFile(it->second);
+	if (it->second.cond != NULL) {
+		pthread_cond_destroy(it->second.cond);
+		delete it->second.cond;
+	}
+	files.erase(it);
+}
+
+/*
+ * to evict other files until cached files fit in XYZ_CACHE_MEMORY_BUDGET.
+ * unreferenced files first, then the least recently used.
+ * files being loaded or copied are not evicted.
+ * mutex_files must be held.
+ */
+void CacheManager::evictFiles(string loading) {
+	while (fileBytes > XYZ_CACHE_MEMORY_BUDGET) {
+		map<string, xyz_cache_file_entry_>::iterator it, victim = files.end();
+		for (it = files.begin(); it != files.end(); ++it) {
+			if (it->first == loading || it->second.size == 0) continue;
+			if (it->second.inUse()) continue;
+			if (victim == files.end()
+					|| (it->second.refs == 0 && victim->second.refs > 0)
+					|| ((it->second.refs == 0) == (victim->second.refs == 0)
+							&& it->second.lastUsed < victim->second.lastUsed)) {
+				victim = it;
+			}
+		}
+		if (victim == files.end()) break; // only files in use
+
+		stringstream ss;
+		ss << "CacheManager: file [" << victim->first << "] evicted, "
+				<< victim->second.size << " bytes";
+		Logging::logDebug(ss.str());
+
+		if (victim->second.refs <= 0) eraseFile(victim);
+		else freeFile(victim->second);
+	}
+}
+
+/*
+ * to save output of a map task of a shuffle
+ */
+void CacheManager::saveShuffle(long shuffleID, DataCache *cache) {
+	pthread_mutex_lock(&mutex_shuffles);
+	shuffles[shuffleID].caches.push_back(cache);
+	pthread_mutex_unlock(&mutex_shuffles);
+}
+
+/*
+ * to get map output of a shuffle to serve a request.
+ * the shuffle will not be released before releaseShuffleReader.
+ */
+vector<DataCache *> * CacheManager::acquireShuffle(long shuffleID) {
+	vector<DataCache *> *ret = NULL;
+	pthread_mutex_lock(&mutex_shuffles);
+	map<long, xyz_cache_shuffle_entry_>::iterator it = shuffles.find(shuffleID);
+	if (it != shuffles.end()) {
+		it->second.readers++;
+		ret = &it->second.caches;
+	}
+	pthread_mutex_unlock(&mutex_shuffles);
+	return ret;
+}
+
+/*
+ * a request on a shuffle has been served
+ */
+void CacheManager::releaseShuffleReader(long shuffleID) {
+	pthread_mutex_lock(&mutex_shuffles);
+	map<long, xyz_cache_shuffle_entry_>::iterator it = shuffles.find(shuffleID);
+	if (it != shuffles.end()) {
+		it->second.readers--;
+		if (it->second.readers <= 0) pthread_cond_broadcast(&cond_shuffle_readers);
+	}
+	pthread_mutex_unlock(&mutex_shuffles);
+}
+
+/*
+ * to stop serving a shuffle, after requests being served finish.
+ * the map output can be destroyed afterwards.
+ */
+void CacheManager::releaseShuffle(long shuffleID) {
+	pthread_mutex_lock(&mutex_shuffles);
+	map<long, xyz_cache_shuffle_entry_>::iterator it = shuffles.find(shuffleID);
+	while (it != shuffles.end() && it->second.readers > 0) {
+		pthread_cond_wait(&cond_shuffle_readers, &mutex_shuffles);
+		it = shuffles.find(shuffleID);
+	}
+	if (it != shuffles.end()) shuffles.erase(it);
+	pthread_mutex_unlock(&mutex_shuffles);
+}
+
+/*
+ * to stop serving all shuffles
+ */
+void CacheManager::clearShuffles() {
+	pthread_mutex_lock(&mutex_shuffles);
+	shuffles.clear();
+	pthread_mutex_unlock(&mutex_shuffles);
+}
+
+#endif /* INCLUDE_CACHEMANAGER_HPP_ */
@@ -0,0 +1,22 @@
+/*
+ * CoalescedPartition.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_COALESCEDPARTITION_HPP_
+#define INCLUDE_COALESCEDPARTITION_HPP_
+
+#include "CoalescedPartition.h"
+
+#include "Partition.hpp"
+
+/*
+ * constructor
+ */
+CoalescedPartition::CoalescedPartition(long rddID, int partitionID, vector<Partition*> &parents)
+: rddID(rddID), partitionID(partitionID), parents(parents)
+{
+}
+
+#endif /* INCLUDE_COALESCEDPARTITION_HPP_ */
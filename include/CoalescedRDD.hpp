@@ -0,0 +1,196 @@
+/*
+ * CoalescedRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_COALESCEDRDD_HPP_
+#define INCLUDE_COALESCEDRDD_HPP_
+
+#include "CoalescedRDD.h"
+
+#include <map>
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "CoalescedPartition.hpp"
+#include "RDD.hpp"
+
+/*
+ * constructor, accepting previous RDD and the number of partitions
+ */
+template <class T>
+CoalescedRDD<T>::CoalescedRDD(RDD<T> *prev, int numPartitions)
+:RDD<T>::RDD(prev->context), prevRDD(prev), numPartitions(numPartitions)
+{
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class T>
+CoalescedRDD<T>::~CoalescedRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * shuffle the previous RDD, then group its partitions.
+ */
+template <class T>
+void CoalescedRDD<T>::shuffle()
+{
+	prevRDD->shuffle();
+	this->coalesce();
+}
+
+/*
+ * get partitions of this RDD, grouping partitions of previous RDD first if not yet.
+ */
+template <class T>
+vector<Partition*> CoalescedRDD<T>::getPartitions()
+{
+	if(RDD<T>::partitions.size() == 0) {
+		this->coalesce();
+	}
+	return RDD<T>::partitions;
+}
+
+/*
+ * to group partitions of previous RDD into numPartitions partitions, once.
+ * partitions are ordered by their preferred host, and cut into groups of even sizes,
+ * so only groups at the border of two hosts have partitions of both.
+ */
+template <class T>
+void CoalescedRDD<T>::coalesce()
+{
+	if(RDD<T>::partitions.size() > 0) {
+		return;
+	}
+
+	vector<Partition*> pars = prevRDD->getPartitions();
+	int groups = numPartitions < (int)pars.size() ? numPartitions : pars.size();
+	if(groups < 1) {
+		groups = 1;
+	}
+
+	// order partitions by the host they prefer, hosts in the order first seen
+	vector<string> hosts;
+	std::map<string, vector<Partition*> > hostPartitions;
+	for(size_t i = 0; i < pars.size(); i++) {
+		vector<string> locations = prevRDD->getPreferredLocations(pars[i]);
+		string host = locations.size() > 0 ? locations[0] : "";
+		if(hostPartitions.find(host) == hostPartitions.end()) {
+			hosts.push_back(host);
+		}
+		hostPartitions[host].push_back(pars[i]);
+	}
+	vector<Partition*> ordered;
+	for(size_t i = 0; i < hosts.size(); i++) {
+		vector<Partition*> &hps = hostPartitions[hosts[i]];
+		ordered.insert(ordered.end(), hps.begin(), hps.end());
+	}
+
+	// cut into groups, sizes differ by at most one
+	size_t begin = 0;
+	for(int i = 0; i < groups; i++) {
+		size_t end = ordered.size() * (i + 1) / groups;
+		vector<Partition*> parents(ordered.begin() + begin, ordered.begin() + end);
+		RDD<T>::partitions.push_back(new CoalescedPartition(this->rddID, i, parents));
+		begin = end;
+	}
+}
+
+/*
+ * the host preferred by most partitions of the group
+ */
+template <class T>
+vector<string> CoalescedRDD<T>::preferredLocations(Partition *p)
+{
+	CoalescedPartition *cp = dynamic_cast<CoalescedPartition *>(p);
+	std::map<string, int> counts;
+	vector<string> ret;
+	int most = 0;
+	for(size_t i = 0; i < cp->parents.size(); i++) {
+		vector<string> locations = prevRDD->getPreferredLocations(cp->parents[i]);
+		if(locations.size() == 0) {
+			continue;
+		}
+		int count = ++counts[locations[0]];
+		if(count > most) {
+			most = count;
+			ret = vector<string>(1, locations[0]);
+		}
+	}
+	return ret;
+}
+
+/*
+ * a task on the partition computes the grouped partitions of previous RDD as well.
+ */
+template <class T>
+void CoalescedRDD<T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<T>::partitionScheduled(p, host);
+	CoalescedPartition *cp = dynamic_cast<CoalescedPartition *>(p);
+	for(size_t i = 0; i < cp->parents.size(); i++) {
+		prevRDD->partitionScheduled(cp->parents[i], host);
+	}
+}
+
+/*
+ * the number of values in grouped partitions of previous RDD, unless this RDD is persisted.
+ */
+template <class T>
+size_t CoalescedRDD<T>::countPartition(Partition *p)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD<T>::countPartition(p);
+	}
+	CoalescedPartition *cp = dynamic_cast<CoalescedPartition *>(p);
+	size_t ret = 0;
+	for(size_t i = 0; i < cp->parents.size(); i++) {
+		ret += prevRDD->countPartition(cp->parents[i]);
+	}
+	return ret;
+}
+
+/*
+ * get the data set in the partition, values of grouped partitions one after another.
+ * a group of one partition is returned as previous RDD computes it.
+ */
+template <class T>
+IteratorSeq<T> * CoalescedRDD<T>::iteratorSeq(Partition *p)
+{
+	CoalescedPartition *cp = dynamic_cast<CoalescedPartition *>(p);
+	if(cp->parents.size() == 1) {
+		return prevRDD->getOrCompute(cp->parents[0]);
+	}
+
+	vector<IteratorSeq<T> *> seqs;
+	size_t total = 0;
+	for(size_t i = 0; i < cp->parents.size(); i++) {
+		IteratorSeq<T> *seq = prevRDD->getOrCompute(cp->parents[i]);
+		seqs.push_back(seq);
+		total += seq->size();
+	}
+
+	vector<T> output;
+	output.reserve(total);
+	for(size_t i = 0; i < seqs.size(); i++) {
+		size_t n = seqs[i]->size();
+		for(size_t j = 0; j < n; j++) {
+			output.push_back(seqs[i]->at(j));
+		}
+	}
+
+	VectorIteratorSeq<T> *ret = new VectorIteratorSeq<T>();
+	ret->swap(output);
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+#endif /* INCLUDE_COALESCEDRDD_HPP_ */
@@ -21,20 +21,30 @@ using namespace std;
  * constructor
  */
 template <class T>
-CollectTask<T>::CollectTask(RDD<T> *r, Partition *p)
-:RDDTask< T, vector<T> >::RDDTask(r, p)
+CollectTask<T>::CollectTask(RDD<T> *r, Partition *p, long limit)
+:RDDTask< T, vector<T> >::RDDTask(r, p), limit(limit)
 {
 }
 
 /*
  * running the task.
- * for CollectTask, just return the partition data in vector.
+ * for CollectTask, just return the partition data in vector,
+ * or the first values of it if limited.
  */
 template <class T>
 vector<T> CollectTask<T>::run()
 {
-	IteratorSeq<T> *iter = RDDTask< T, vector<T> >::rdd->iteratorSeq(RDDTask< T, vector<T> >::partition);
-	return iter->getVector();
+	IteratorSeq<T> *iter = RDDTask< T, vector<T> >::rdd->getOrCompute(RDDTask< T, vector<T> >::partition);
+	if(limit < 0 || (size_t)limit >= iter->size()) {
+		return iter->getVector();
+	}
+
+	vector<T> ret;
+	ret.reserve(limit);
+	for(long i = 0; i < limit; i++) {
+		ret.push_back(iter->at(i));
+	}
+	return ret;
 }
 
 /*
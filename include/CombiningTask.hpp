@@ -0,0 +1,81 @@
+/*
+ * CombiningTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_COMBININGTASK_HPP_
+#define INCLUDE_COMBININGTASK_HPP_
+
+#include "CombiningTask.h"
+
+#include "ShuffledTask.hpp"
+#include "FlatCombinerMap.hpp"
+#include "NodeCombiner.hpp"
+#include "Pair.hpp"
+
+/*
+ * constructor
+ */
+template <class K, class V, class C>
+CombiningTask<K, V, C>::CombiningTask(RDD< Pair<K, V> > *r, Partition *p, long shID, int nPs,
+		HashDivider &hashDivider,
+		Aggregator< Pair<K, V>, Pair<K, C> > &aggregator,
+		long (*hFunc)(Pair<K, C> &p),
+		string (*sf)(Pair<K, C> &p))
+: ShuffledTask< Pair<K, V>, Pair<K, C> >::ShuffledTask(r, p, shID, nPs, hashDivider, aggregator, hFunc, sf)
+{
+	nodeCombiner = NULL;
+}
+
+/*
+ * to merge output into combined output of this node.
+ * must be set before running.
+ */
+template <class K, class V, class C>
+void CombiningTask<K, V, C>::setNodeCombiner(NodeCombiner<K, V, C> *nc) {
+	nodeCombiner = nc;
+}
+
+/*
+ * to merge a combiner with the combiner of the same key in its new partition
+ */
+template <class K, class V, class C>
+void CombiningTask<K, V, C>::addToPartition(int part, Pair<K, C> &p) {
+	if(combiners.size() == 0) combiners.resize(this->numPartitions);
+
+	combiners[part].merge(p, this->agg);
+}
+
+/*
+ * to hand combined pairs over to new partitions, or to the node combiner.
+ * pairs merged into the node combiner are counted in map status here too,
+ * their bytes are estimated by serializing a few of them.
+ * partitions are merged starting from different ones in different tasks,
+ * so tasks finishing together do not wait for the same lock.
+ */
+template <class K, class V, class C>
+void CombiningTask<K, V, C>::finishPartitions() {
+	for(size_t k = 0; k < combiners.size(); k++) {
+		size_t i = (k + this->taskID) % combiners.size();
+		vector< Pair<K, C> > pairs;
+		combiners[i].swap(pairs);
+		if(nodeCombiner == NULL) {
+			this->partitions[i]->swap(pairs);
+			continue;
+		}
+
+		size_t sampled = 0, sampledBytes = 0;
+		for(; sampled < pairs.size() && sampled < 16; sampled++) {
+			sampledBytes += this->strFunc(pairs[sampled]).size();
+		}
+		this->status.records[i] = pairs.size();
+		if(sampled > 0) {
+			this->status.bytes[i] = sampledBytes * pairs.size() / sampled;
+		}
+		nodeCombiner->merge(i, pairs);
+	}
+	combiners.clear();
+}
+
+#endif /* INCLUDE_COMBININGTASK_HPP_ */
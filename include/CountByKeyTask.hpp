@@ -0,0 +1,84 @@
+/*
+ * CountByKeyTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_COUNTBYKEYTASK_HPP_
+#define INCLUDE_COUNTBYKEYTASK_HPP_
+
+#include "CountByKeyTask.h"
+
+#include "IteratorSeq.hpp"
+#include "RDDTask.hpp"
+#include "FlatCombinerMap.hpp"
+#include "Pair.hpp"
+#include "Utils.hpp"
+#include "StringConversion.hpp"
+
+/*
+ * constructor
+ */
+template <class T, class K>
+CountByKeyTask<T, K>::CountByKeyTask(RDD<T> *r, Partition *p, K (*keyFunc)(T&))
+:RDDTask< T, vector< Pair<K, long> > >::RDDTask(r, p), keyFunc(keyFunc)
+{
+}
+
+/*
+ * to count values in the partition by key
+ */
+template <class T, class K>
+vector< Pair<K, long> > CountByKeyTask<T, K>::run() {
+	IteratorSeq<T> *seq = RDDTask< T, vector< Pair<K, long> > >::rdd->getOrCompute(
+			RDDTask< T, vector< Pair<K, long> > >::partition);
+	FlatCombinerMap<K, long> counts;
+	long one = 1;
+	size_t n = seq->size();
+	for (size_t i = 0; i < n; i++) {
+		T t = seq->at(i);
+		K k = keyFunc(t);
+		Pair<K, long> p(k, one);
+		bool inserted;
+		Pair<K, long> *c = counts.insert(p, inserted);
+		if (!inserted) {
+			c->v2++;
+		}
+	}
+
+	vector< Pair<K, long> > ret;
+	counts.swap(ret);
+	return ret;
+}
+
+/*
+ * to serialize the task result
+ */
+template <class T, class K>
+string CountByKeyTask<T, K>::serialize(vector< Pair<K, long> > &t) {
+	string ret = "";
+	for (unsigned int i=0; i<t.size(); i++) {
+		ret += to_string(t[i]);
+		if (i != t.size()-1) ret += COUNT_TASK_DELIMITATION;
+	}
+	return ret;
+}
+
+/*
+ * to deserialize a string to task result
+ */
+template <class T, class K>
+vector< Pair<K, long> > CountByKeyTask<T, K>::deserialize(string &s) {
+	vector< Pair<K, long> > elems;
+	vector<string> vs;
+	splitString(s, vs, COUNT_TASK_DELIMITATION);
+
+	for(unsigned int i=0; i<vs.size(); i++) {
+		Pair<K, long> p;
+		from_string(p, vs[i]);
+		elems.push_back(p);
+	}
+	return elems;
+}
+
+#endif /* INCLUDE_COUNTBYKEYTASK_HPP_ */
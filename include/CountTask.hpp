@@ -0,0 +1,50 @@
+/*
+ * CountTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_COUNTTASK_HPP_
+#define INCLUDE_COUNTTASK_HPP_
+
+#include "CountTask.h"
+
+#include "RDDTask.hpp"
+#include "StringConversion.hpp"
+
+/*
+ * constructor
+ */
+template <class T>
+CountTask<T>::CountTask(RDD<T> *r, Partition *p)
+:RDDTask<T, long>::RDDTask(r, p)
+{
+}
+
+/*
+ * to count values in the partition
+ */
+template <class T>
+long CountTask<T>::run() {
+	return RDDTask<T, long>::rdd->countPartition(RDDTask<T, long>::partition);
+}
+
+/*
+ * to serialize the task result
+ */
+template <class T>
+string CountTask<T>::serialize(long &t) {
+	return to_string(t);
+}
+
+/*
+ * to deserialize a string to task result
+ */
+template <class T>
+long CountTask<T>::deserialize(string &s) {
+	long t = 0;
+	from_string(t, s);
+	return t;
+}
+
+#endif /* INCLUDE_COUNTTASK_HPP_ */
@@ -0,0 +1,132 @@
+/*
+ * FilteredRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_FILTEREDRDD_HPP_
+#define INCLUDE_FILTEREDRDD_HPP_
+
+#include "FilteredRDD.h"
+
+#include "IteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+#include "HashDivider.hpp"
+
+/*
+ * constructor, accepting previous RDD and filter function pointer
+ */
+template <class T>
+FilteredRDD<T>::FilteredRDD(RDD<T> *prev, bool (*f)(T&))
+:RDD<T>::RDD(prev->context), prevRDD(prev), filterFunction(f),
+ inputValues(0), outputValues(0)
+{
+	pthread_mutex_init(&mutex_selectivity, NULL);
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class T>
+FilteredRDD<T>::~FilteredRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+	pthread_mutex_destroy(&mutex_selectivity);
+}
+
+/*
+ * shuffle the previous RDD, this FilteredRDD does not need to shuffle
+ */
+template <class T>
+void FilteredRDD<T>::shuffle()
+{
+	prevRDD->shuffle();
+}
+
+/*
+ * get partitions of this RDD.
+ * all partitions are from its previous RDD.
+ */
+template <class T>
+vector<Partition*> FilteredRDD<T>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get the preferred locations of the partition, the same as in previous RDD
+ */
+template <class T>
+vector<string> FilteredRDD<T>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class T>
+void FilteredRDD<T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<T>::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class T>
+size_t FilteredRDD<T>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
+}
+
+/*
+ * filtering keeps keys in their partitions, so the partitioner of previous RDD holds.
+ */
+template <class T>
+HashDivider * FilteredRDD<T>::getPartitioner()
+{
+	return prevRDD->getPartitioner();
+}
+
+/*
+ * get the data set in the partition.
+ * previous RDD filters values as it computes them,
+ * and the fraction of values passing is counted for later partitions.
+ */
+template <class T>
+IteratorSeq<T> * FilteredRDD<T>::iteratorSeq(Partition *p)
+{
+	size_t count = 0;
+	IteratorSeq<T> *ret = prevRDD->filteredIteratorSeq(p, filterFunction, this->selectivity(), count);
+	this->addIteratorSeq(ret); // for garbage collection
+
+	pthread_mutex_lock(&mutex_selectivity);
+	inputValues += count;
+	outputValues += ret->size();
+	pthread_mutex_unlock(&mutex_selectivity);
+	return ret;
+}
+
+/*
+ * expected fraction of values passing the filter, from partitions computed before.
+ * it is a little more than counted, so the output is seldom grown.
+ */
+template <class T>
+double FilteredRDD<T>::selectivity()
+{
+	pthread_mutex_lock(&mutex_selectivity);
+	double s = inputValues == 0 ? -1 : (double)outputValues / inputValues;
+	pthread_mutex_unlock(&mutex_selectivity);
+	if(s < 0) {
+		return s;
+	}
+	s = s * 1.05 + 0.001;
+	return s > 1 ? 1 : s;
+}
+
+#endif /* INCLUDE_FILTEREDRDD_HPP_ */
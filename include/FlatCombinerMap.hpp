@@ -0,0 +1,124 @@
+/*
+ * FlatCombinerMap.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_FLATCOMBINERMAP_HPP_
+#define INCLUDE_FLATCOMBINERMAP_HPP_
+
+#include "FlatCombinerMap.h"
+
+#include <tr1/unordered_map>
+
+#include "Pair.hpp"
+#include "Aggregator.hpp"
+
+/*
+ * to spread hash codes over all bits,
+ * std::tr1::hash of integers is the integer itself
+ */
+inline size_t xyz_flat_combiner_map_mix_f(size_t h) {
+	h ^= h >> 33;
+	h *= (size_t)0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/*
+ * constructor
+ */
+template <class K, class C>
+FlatCombinerMap<K, C>::FlatCombinerMap()
+: mask(0) {
+}
+
+/*
+ * to find the pair with the same key as p.
+ * if not found, p is inserted, and inserted is set true.
+ * the returned pointer is valid until the next insert.
+ */
+template <class K, class C>
+Pair<K, C> * FlatCombinerMap<K, C>::insert(Pair<K, C> &p, bool &inserted) {
+	if ((pairs.size() + 1) * 4 > slots.size() * 3) { // load factor 0.75
+		rehash(slots.size() == 0 ? 16 : slots.size() * 2);
+	}
+
+	size_t h = xyz_flat_combiner_map_mix_f(std::tr1::hash<K>()(p.v1));
+	size_t i = h & mask;
+	while (slots[i] != 0) {
+		size_t index = slots[i] - 1;
+		if (hashes[index] == h && pairs[index].v1 == p.v1) {
+			inserted = false;
+			return &pairs[index];
+		}
+		i = (i + 1) & mask;
+	}
+
+	slots[i] = pairs.size() + 1;
+	pairs.push_back(p);
+	hashes.push_back(h);
+	inserted = true;
+	return &pairs.back();
+}
+
+/*
+ * to merge a combiner with the combiner of the same key by Aggregator::mergeCombiners,
+ * or to insert it if the key is new
+ */
+template <class K, class C>
+template <class T>
+void FlatCombinerMap<K, C>::merge(Pair<K, C> &p, Aggregator< T, Pair<K, C> > &agg) {
+	bool inserted = false;
+	Pair<K, C> *origin = this->insert(p, inserted);
+	if (!inserted) {
+		Pair<K, C> newPair = agg.mergeCombiners(*origin, p);
+		origin->v2 = newPair.v2;
+	}
+}
+
+/*
+ * number of pairs
+ */
+template <class K, class C>
+size_t FlatCombinerMap<K, C>::size() const {
+	return pairs.size();
+}
+
+/*
+ * to hand over all pairs to v, in insertion order
+ */
+template <class K, class C>
+void FlatCombinerMap<K, C>::swap(vector< Pair<K, C> > &v) {
+	v.swap(pairs);
+	clear();
+}
+
+/*
+ * to remove all pairs
+ */
+template <class K, class C>
+void FlatCombinerMap<K, C>::clear() {
+	vector< Pair<K, C> >().swap(pairs);
+	vector<size_t>().swap(hashes);
+	vector<size_t>().swap(slots);
+	mask = 0;
+}
+
+/*
+ * to rebuild the table with capacity slots, which is a power of 2
+ */
+template <class K, class C>
+void FlatCombinerMap<K, C>::rehash(size_t capacity) {
+	slots.assign(capacity, 0);
+	mask = capacity - 1;
+	for (size_t index = 0; index < pairs.size(); index++) {
+		size_t i = hashes[index] & mask;
+		while (slots[i] != 0) {
+			i = (i + 1) & mask;
+		}
+		slots[i] = index + 1;
+	}
+}
+
+#endif /* INCLUDE_FLATCOMBINERMAP_HPP_ */
@@ -69,7 +69,26 @@ vector<Partition *> FlatMappedRDD<U, T>::getPartitions()
 template <class U, class T>
 vector<string> FlatMappedRDD<U, T>::preferredLocations(Partition *p)
 {
-	return prevRDD->preferredLocations(p);
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class U, class T>
+void FlatMappedRDD<U, T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<U>::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class U, class T>
+size_t FlatMappedRDD<U, T>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
 }
 
 /*
@@ -79,7 +98,7 @@ vector<string> FlatMappedRDD<U, T>::preferredLocations(Partition *p)
 template <class U, class T>
 IteratorSeq<U> * FlatMappedRDD<U, T>::iteratorSeq(Partition *p)
 {
-	IteratorSeq<U> * ret = prevRDD->iteratorSeq(p)->flatMap(mappedFunction);
+	IteratorSeq<U> * ret = prevRDD->getOrCompute(p)->flatMap(mappedFunction);
 	this->addIteratorSeq(ret); // for garbage collection
 	return ret;
 }
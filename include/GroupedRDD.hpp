@@ -0,0 +1,317 @@
+/*
+ * GroupedRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_GROUPEDRDD_HPP_
+#define INCLUDE_GROUPEDRDD_HPP_
+
+#include "GroupedRDD.h"
+
+#include <map>
+#include <new>
+#include <algorithm>
+#include <utility>
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "ShuffledPartition.hpp"
+#include "BaseShuffledRDD.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "SunwayMRContext.hpp"
+#include "ShuffledTask.hpp"
+#include "MessageDecoder.hpp"
+#include "Aggregator.hpp"
+#include "HashDivider.hpp"
+#include "TaskResult.hpp"
+#include "Task.hpp"
+#include "Messaging.hpp"
+#include "Utils.hpp"
+#include "TaskScheduler.hpp"
+#include "VectorAutoPointer.hpp"
+
+using namespace std;
+
+/*
+ * create combiner for ShuffledTask, pairs are not combined when grouping
+ */
+template <class K, class V>
+Pair<K, V> xyz_grouped_rdd_create_combiner_f(Pair<K, V> &p) {
+	return p;
+}
+
+/*
+ * constructor
+ */
+template <class K, class V>
+GroupedRDD<K, V>::GroupedRDD(RDD< Pair<K, V> > *_prevRDD,
+		HashDivider &_hd,
+		long (*hf)(Pair<K, V> &p),
+		string (*strf)(Pair<K, V> &p),
+		Pair<K, V> (*_recoverFunc)(string &s))
+: BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, VectorIteratorSeq<V> > >::BaseShuffledRDD(_prevRDD, _hd, "GroupedRDD"),
+  agg(xyz_grouped_rdd_create_combiner_f<K, V>, NULL)
+{
+	hashFunc = hf;
+	strFunc = strf;
+	recoverFunc = _recoverFunc;
+	joinLeftTasks = 0;
+
+	// construct shuffle tasks
+	vector<Partition*> pars = this->prevRDD->getPartitions(); //partitions before shuffle
+	for (unsigned int i = 0; i < pars.size(); i++)
+	{
+		ShuffledTask< Pair<K, V>, Pair<K, V> > *task =
+				new ShuffledTask< Pair<K, V>, Pair<K, V> >(
+						this->prevRDD, pars[i], this->shuffleID, this->hd.getNumPartitions(),
+						this->hd, agg, hashFunc, strFunc);
+		this->shuffledTasks.push_back(task);
+	}
+}
+
+/*
+ * groups are partitioned by hash of keys,
+ * unless partitions have been coalesced.
+ */
+template <class K, class V>
+HashDivider * GroupedRDD<K, V>::getPartitioner()
+{
+	if(this->hashPartitions.size() > 0) return NULL;
+	return &this->hd;
+}
+
+/*
+ * to group the two sides of a join, which are partitions of a UnionRDD, the left side first.
+ * skewed or large partitions may be split then, see splitPartitions.
+ * must be set before shuffle.
+ */
+template <class K, class V>
+void GroupedRDD<K, V>::setJoinSides(int leftTasks)
+{
+	joinLeftTasks = leftTasks;
+}
+
+/*
+ * to coalesce small partitions if adaptive, then split skewed or large partitions of a join.
+ */
+template <class K, class V>
+void GroupedRDD<K, V>::afterMapStage()
+{
+	BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, VectorIteratorSeq<V> > >::afterMapStage();
+	if(joinLeftTasks > 0) {
+		this->splitPartitions();
+	}
+}
+
+/*
+ * to split skewed partitions of a join by map statuses.
+ * a partition is skewed if its map output is far larger than the median, as hot keys make it.
+ * if adaptive, a partition larger than the target size is split too.
+ * output of its larger side is split by ranges of map tasks, and each slice is grouped
+ * with the whole output of its smaller side, so values of the hot keys on the smaller side
+ * are replicated to every slice, and each joined pair is still made by exactly one slice.
+ * groups of groupByKey are never split, as each key has exactly one group.
+ */
+template <class K, class V>
+void GroupedRDD<K, V>::splitPartitions()
+{
+	int numTasks = this->mapStatuses.size();
+	if(joinLeftTasks >= numTasks) return;
+
+	vector<long> left = MapStatus::partitionBytes(this->mapStatuses, 0, joinLeftTasks);
+	vector<long> right = MapStatus::partitionBytes(this->mapStatuses, joinLeftTasks, numTasks);
+	vector<long> bytes(left.size(), 0);
+	for(size_t j = 0; j < bytes.size() && j < right.size(); j++) {
+		bytes[j] = left[j] + right[j];
+	}
+	long median = 0;
+	vector<int> partitionSlices = MapStatus::partitionSlices(bytes, this->adaptive,
+			this->context->getTotalThreads(), median);
+
+	int nextID = this->shuffleMutexes.size(); // after IDs of all partitions so far
+	bool split = false;
+	vector<Partition*> parts;
+	for(size_t i = 0; i < this->partitions.size(); i++) {
+		ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(this->partitions[i]);
+		int p = srp->firstPartition;
+		if(srp->lastPartition != p + 1 || partitionSlices[p] < 2) {
+			parts.push_back(this->partitions[i]); // not split, or coalesced with others
+			continue;
+		}
+
+		// map tasks of the larger side, split into slices of about the same bytes
+		bool leftLarger = left[p] >= right[p];
+		int first = leftLarger ? 0 : joinLeftTasks;
+		int last = leftLarger ? joinLeftTasks : numTasks;
+		int slices = partitionSlices[p];
+		if(slices > last - first) slices = last - first;
+		vector<int> starts;
+		if(slices >= 2) {
+			MapStatus::splitTasks(this->mapStatuses, p, first, last, slices, starts);
+		}
+		if(starts.size() < 2) {
+			parts.push_back(this->partitions[i]);
+			continue;
+		}
+
+		pair<int, int> smaller = leftLarger ? make_pair(joinLeftTasks, numTasks) : make_pair(0, joinLeftTasks);
+		for(size_t r = 0; r < starts.size(); r++) {
+			vector< pair<int, int> > ranges;
+			ranges.push_back(make_pair(starts[r], r + 1 < starts.size() ? starts[r + 1] : last));
+			ranges.push_back(smaller);
+			parts.push_back(new ShuffledPartition(this->rddID, nextID++, p, ranges));
+		}
+		split = true;
+
+		stringstream ss;
+		ss << "GroupedRDD: partition [" << p << "] of shuffle [" << this->shuffleID << "] has "
+				<< bytes[p] << " bytes against median " << median << ", its "
+				<< (leftLarger ? "left" : "right") << " side is split into [" << starts.size() << "] slices";
+		Logging::logInfo(ss.str());
+	}
+	if(split) {
+		this->replacePartitions(parts);
+	}
+}
+
+/*
+ * to get data set of a partition.
+ * this is done by several steps:
+ *   1) to decode serialized pairs of local ShuffledTasks from their output buffers
+ *   2) to fetch pairs from other nodes, appending values of all pairs to groups of their keys while received
+ *   3) to hand groups over to result pairs, save cache and return
+ * a slice of a skewed partition only reads output of map tasks in its ranges.
+ */
+template <class K, class V>
+IteratorSeq< Pair<K, VectorIteratorSeq<V> > > * GroupedRDD<K, V>::iteratorSeq(Partition *p)
+{
+	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
+
+	// checking cache
+	IteratorSeq< Pair<K, VectorIteratorSeq<V> > > *cached = this->lockPartition(srp);
+	if (cached != NULL) {
+		return cached;
+	}
+
+	// groups are kept in a deque, which never moves existing groups when one is added,
+	// so values appended so far are not copied however many keys the partition has
+	unordered_map<K, size_t> index; // key -> position in keys and groups
+	vector<K> keys;
+	deque< vector<V> > groups;
+
+	GroupedDataDecoder<K, V> decoder(this, index, keys, groups);
+	for(int part = srp->firstPartition; part < srp->lastPartition; part++) {
+		// local data is decoded in place
+		for(size_t i = 0; i < this->shuffledTasks.size(); i++) {
+			if(srp->hasTask(i)) {
+				this->shuffledTasks[i]->decodeData(part, decoder);
+			}
+		}
+
+		// fetch, appending while received
+		int port = (this->context)->getListenPort();
+		if(srp->taskRanges.size() == 0) {
+			vector<string> IPs = (this->context)->getHosts();
+			this->fetchShuffleData(IPs, port, this->shuffleID, part, -1, -1, decoder);
+		}
+		for(size_t r = 0; r < srp->taskRanges.size(); r++) {
+			// only hosts where the map tasks ran
+			int first = srp->taskRanges[r].first, last = srp->taskRanges[r].second;
+			vector<string> IPs;
+			for(int i = first; i < last && i < (int)this->mapStatuses.size(); i++) {
+				if(find(IPs.begin(), IPs.end(), this->mapStatuses[i].host) == IPs.end()) {
+					IPs.push_back(this->mapStatuses[i].host);
+				}
+			}
+			this->fetchShuffleData(IPs, port, this->shuffleID, part, first, last, decoder);
+		}
+	}
+	index.clear();
+	if (decoder.getInvalid() > 0) {
+		stringstream ss;
+		ss << decoder.getInvalid() << " invalid pairs found in GroupedRDD::iteratorSeq()";
+		Logging::logWarning(ss.str());
+	}
+
+	// making result, values are swapped into place instead of copied
+	vector< Pair<K, VectorIteratorSeq<V> > > ret;
+	ret.reserve(keys.size());
+	for(size_t i = 0; i < keys.size(); i++) {
+		VectorIteratorSeq<V> group;
+		ret.push_back(Pair<K, VectorIteratorSeq<V> >(keys[i], group));
+		ret.back().v2.swap(groups.front());
+		groups.pop_front();
+	}
+	VectorIteratorSeq< Pair<K, VectorIteratorSeq<V> > > *retIt =
+			new VectorIteratorSeq< Pair<K, VectorIteratorSeq<V> > >();
+	retIt->swap(ret);
+
+	// saving cache
+	this->unlockPartition(srp, retIt);
+
+	return retIt;
+}
+
+/*
+ * to append the value of a pair to the group of its key
+ */
+template <class K, class V>
+void GroupedRDD<K, V>::append(Pair<K, V> &p, unordered_map<K, size_t> &index,
+		vector<K> &keys, deque< vector<V> > &groups)
+{
+	typename unordered_map<K, size_t>::iterator iter = index.find(p.v1);
+	if(iter != index.end()) {
+		groups[iter->second].push_back(p.v2);
+	}
+	else {
+		index[p.v1] = keys.size();
+		keys.push_back(p.v1);
+		groups.push_back(vector<V>(1, p.v2));
+	}
+}
+
+/*
+ * constructor of GroupedDataDecoder
+ */
+template <class K, class V>
+GroupedDataDecoder<K, V>::GroupedDataDecoder(GroupedRDD<K, V> *rdd, unordered_map<K, size_t> &index,
+		vector<K> &keys, deque< vector<V> > &groups)
+: RecordDecoder(SHUFFLETASK_KV_DELIMITATION), rdd(rdd), index(index), keys(keys), groups(groups), invalid(0) {
+}
+
+/*
+ * to append the value of a pair to its group as soon as it is decoded
+ */
+template <class K, class V>
+void GroupedDataDecoder<K, V>::record(string &s)
+{
+	if(s == SHUFFLETASK_EMPTY_DELIMITATION || s == EMPTY_MESSAGE)
+		return;
+
+	Pair<K, V> p;
+	try {
+		p = rdd->recoverFunc(s);
+	} catch (std::bad_alloc& ba) {
+		invalid ++;
+		return; // converting from string failed
+	}
+	if (!p.valid) {
+		invalid ++;
+		return; // converting from string failed
+	}
+	rdd->append(p, index, keys, groups);
+}
+
+/*
+ * return number of records failed to convert
+ */
+template <class K, class V>
+int GroupedDataDecoder<K, V>::getInvalid()
+{
+	return invalid;
+}
+
+#endif /* INCLUDE_GROUPEDRDD_HPP_ */
@@ -53,6 +53,26 @@ template <class U> IteratorSeq<U> * IteratorSeq<T>::flatMap(vector<U> (*f)(T&))
 	return ret;
 }
 
+/*
+ * filtering elements in this IteratorSeq into a new IteratorSeq.
+ * only elements passing the filter function are kept.
+ */
+template <class T>
+IteratorSeq<T> * IteratorSeq<T>::filter(bool (*f)(T&), size_t expected) {
+	VectorIteratorSeq<T> *ret = new VectorIteratorSeq<T>();
+	ret->reserve(expected);
+
+	size_t n = size();
+	for(size_t i = 0; i < n; i++) {
+		T t = this->at(i);
+		if(f(t)) {
+			ret->push_back(t);
+		}
+	}
+
+	return ret;
+}
+
 /*
  * determine the equality of two IteratorSeq
  */
@@ -16,6 +16,7 @@
 #include "Task.hpp"
 #include "TaskResult.hpp"
 #include "Utils.hpp"
+#include "MemoryGovernor.hpp"
 
 using namespace std;
 
@@ -86,6 +87,9 @@ JobScheduler::JobScheduler(string hostFP, string mas, string appN, int listenP){
 			break;
 		}
 	}
+	if(selfIPIndex >= 0) { // memory of this host bounds running tasks and data kept in memory
+		XYZ_MEMORY_GOVERNOR.setBudget((size_t)memoryVector[selfIPIndex] * XYZ_MEMORY_UNIT);
+	}
 
 }
 
@@ -178,14 +182,38 @@ vector<string> JobScheduler::getHosts() {
 	return IPVector;
 }
 
+/*
+ * get the hosts that tasks of a job will run on,
+ * if none of the tasks has preferred locations.
+ * this is the same distribution as TaskScheduler::runTasks.
+ */
+vector<string> JobScheduler::getTaskHosts(int taskNum) {
+	vector<string> ret(taskNum, selfIP);
+	if (threadCountSum <= 0) return ret;
+
+	int currentTask = 0;
+	while(currentTask < taskNum) {
+		vector<int> threadRemainVector = threadCountVector;
+		int t = taskNum - currentTask;
+		if(t > threadCountSum) t = threadCountSum;
+		for (int i = currentTask; i < currentTask + t; i++) {
+			int index = vectorNonZero(threadRemainVector);
+			if (index != -1) {
+				threadRemainVector[index]--;
+				ret[i] = IPVector[index];
+			}
+		}
+		currentTask += t;
+	}
+	return ret;
+}
+
 /*
  * to run tasks.
  * JobScheduler creates a new TaskScheduler for tasks of each Job.
  */
 template <class T>
 vector< TaskResult<T>* > JobScheduler::runTasks(vector<Task<T>*> &tasks){
-	this->clearAllCache(); // clear cache of previous job
-
 	pthread_mutex_lock(&mutex_job_scheduler);
 	int jobID = nextJobID;
 	nextJobID++;
@@ -295,4 +323,17 @@ void JobScheduler::handleMessage(int localListenPort, string fromHost,
 
 }
 
+/*
+ * task result lists are decoded by the task scheduler while received
+ */
+MessageDecoder * JobScheduler::createDecoder(int localListenPort, string fromHost,
+		int msgType) {
+	if (localListenPort != this->listenPort || fromHost == "") return NULL;
+
+	if (msgType == TASK_RESULT_LIST && taskSchedulers.size() > 0) {
+		return taskSchedulers.back()->createDecoder(localListenPort, fromHost, msgType);
+	}
+	return NULL;
+}
+
 #endif /* JOBSCHEDULER_HPP_ */
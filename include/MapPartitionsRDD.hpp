@@ -0,0 +1,131 @@
+/*
+ * MapPartitionsRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_MAPPARTITIONSRDD_HPP_
+#define INCLUDE_MAPPARTITIONSRDD_HPP_
+
+#include "MapPartitionsRDD.h"
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+
+/*
+ * constructor, accepting previous RDD and the function of a partition
+ */
+template <class U, class T>
+MapPartitionsRDD<U, T>::MapPartitionsRDD(RDD<T> *prev, void (*f)(IteratorSeq<T>&, vector<U>&))
+:RDD<U>::RDD(prev->context), prevRDD(prev),
+ partitionFunction(f), indexedPartitionFunction(NULL)
+{
+}
+
+/*
+ * constructor, accepting previous RDD and the function of a partition with its index
+ */
+template <class U, class T>
+MapPartitionsRDD<U, T>::MapPartitionsRDD(RDD<T> *prev, void (*f)(int, IteratorSeq<T>&, vector<U>&))
+:RDD<U>::RDD(prev->context), prevRDD(prev),
+ partitionFunction(NULL), indexedPartitionFunction(f)
+{
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class U, class T>
+MapPartitionsRDD<U, T>::~MapPartitionsRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * shuffle the previous RDD, this MapPartitionsRDD does not need to shuffle
+ */
+template <class U, class T>
+void MapPartitionsRDD<U, T>::shuffle()
+{
+	prevRDD->shuffle();
+}
+
+/*
+ * get partitions of this RDD.
+ * all partitions are from its previous RDD.
+ */
+template <class U, class T>
+vector<Partition*> MapPartitionsRDD<U, T>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get the preferred locations of the partition, the same as in previous RDD
+ */
+template <class U, class T>
+vector<string> MapPartitionsRDD<U, T>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class U, class T>
+void MapPartitionsRDD<U, T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<U>::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class U, class T>
+size_t MapPartitionsRDD<U, T>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
+}
+
+/*
+ * get the data set in the partition.
+ * the function appends output values directly to the vector of the returned IteratorSeq.
+ */
+template <class U, class T>
+IteratorSeq<U> * MapPartitionsRDD<U, T>::iteratorSeq(Partition *p)
+{
+	IteratorSeq<T> *seq = prevRDD->getOrCompute(p);
+	vector<U> output;
+	if(partitionFunction != NULL) {
+		partitionFunction(*seq, output);
+	} else {
+		indexedPartitionFunction(this->partitionIndex(p), *seq, output);
+	}
+
+	VectorIteratorSeq<U> *ret = new VectorIteratorSeq<U>();
+	ret->swap(output);
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+/*
+ * index of the partition in previous RDD, -1 if not found
+ */
+template <class U, class T>
+int MapPartitionsRDD<U, T>::partitionIndex(Partition *p)
+{
+	vector<Partition*> pars = prevRDD->getPartitions();
+	for(size_t i = 0; i < pars.size(); i++) {
+		if(pars[i] == p) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+#endif /* INCLUDE_MAPPARTITIONSRDD_HPP_ */
@@ -0,0 +1,194 @@
+/*
+ * MapStatus.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_MAPSTATUS_HPP_
+#define INCLUDE_MAPSTATUS_HPP_
+
+#include "MapStatus.h"
+
+#include <algorithm>
+#include <utility>
+using std::pair;
+using std::make_pair;
+
+/*
+ * constructor
+ */
+MapStatus::MapStatus()
+:failed(false) {
+}
+
+/*
+ * constructor with number of new partitions
+ */
+MapStatus::MapStatus(int numPartitions)
+:records(numPartitions, 0), bytes(numPartitions, 0), failed(false) {
+}
+
+/*
+ * to plan reduce partitions after the map stage.
+ * adjacent partitions are coalesced until their bytes reach a target size,
+ * which is XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES, or less to keep every thread busy,
+ * but not less than XYZ_SHUFFLE_ADAPTIVE_MIN_BYTES.
+ * starts holds the first partition of each coalesced partition.
+ */
+void MapStatus::coalescePartitions(vector<MapStatus> &statuses, int parallelism,
+		vector<int> &starts) {
+	if (statuses.size() == 0) return;
+
+	size_t n = statuses[0].bytes.size();
+	vector<long> bytes(n, 0);
+	long total = 0;
+	for (size_t i = 0; i < statuses.size(); i++) {
+		for (size_t j = 0; j < n && j < statuses[i].bytes.size(); j++) {
+			bytes[j] += statuses[i].bytes[j];
+			total += statuses[i].bytes[j];
+		}
+	}
+
+	long target = XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES;
+	if (parallelism > 0 && total / parallelism < target) target = total / parallelism;
+	if (target < XYZ_SHUFFLE_ADAPTIVE_MIN_BYTES) target = XYZ_SHUFFLE_ADAPTIVE_MIN_BYTES;
+
+	long size = 0;
+	for (size_t j = 0; j < n; j++) {
+		if (starts.size() == 0 || (size > 0 && size + bytes[j] > target)) {
+			starts.push_back(j);
+			size = 0;
+		}
+		size += bytes[j];
+	}
+}
+
+/*
+ * to add up bytes of each new partition written by map tasks in [firstTask, lastTask)
+ */
+vector<long> MapStatus::partitionBytes(vector<MapStatus> &statuses, int firstTask, int lastTask) {
+	vector<long> ret;
+	if (statuses.size() == 0) return ret;
+
+	size_t n = statuses[0].bytes.size();
+	ret.assign(n, 0);
+	for (int i = firstTask; i < lastTask && i < (int)statuses.size(); i++) {
+		for (size_t j = 0; j < n && j < statuses[i].bytes.size(); j++) {
+			ret[j] += statuses[i].bytes[j];
+		}
+	}
+	return ret;
+}
+
+/*
+ * to find skewed partitions by bytes of map output, which are measured after map-side combine.
+ * a partition is skewed if it has more than XYZ_SHUFFLE_SKEW_FACTOR times the median bytes,
+ * and at least XYZ_SHUFFLE_SKEW_MIN_BYTES.
+ * the median is not raised by a few huge partitions, as the average would be.
+ */
+vector<int> MapStatus::skewedPartitions(vector<long> &bytes, long &median) {
+	vector<int> ret;
+	median = 0;
+	if (bytes.size() <= 1) return ret;
+
+	vector<long> sorted = bytes;
+	std::sort(sorted.begin(), sorted.end());
+	median = sorted[sorted.size() / 2];
+	for (size_t j = 0; j < bytes.size(); j++) {
+		if (bytes[j] >= XYZ_SHUFFLE_SKEW_MIN_BYTES && bytes[j] > XYZ_SHUFFLE_SKEW_FACTOR * median) {
+			ret.push_back(j);
+		}
+	}
+	return ret;
+}
+
+/*
+ * to plan slices of partitions after the map stage.
+ * a skewed partition is split into slices of about the median bytes, at most parallelism slices,
+ * if XYZ_SHUFFLE_SKEW_MODE is on.
+ * if adaptive, a partition larger than XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES is split into slices of the target size.
+ */
+vector<int> MapStatus::partitionSlices(vector<long> &bytes, bool adaptive, int parallelism,
+		long &median) {
+	vector<int> ret(bytes.size(), 1);
+	vector<int> skewed = skewedPartitions(bytes, median);
+	if (XYZ_SHUFFLE_SKEW_MODE == 1) {
+		for (size_t i = 0; i < skewed.size(); i++) {
+			long slices = median > 0 ? bytes[skewed[i]] / median : parallelism;
+			if (slices > parallelism) slices = parallelism;
+			if (slices > 1) ret[skewed[i]] = (int)slices;
+		}
+	}
+	long target = XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES;
+	for (size_t j = 0; adaptive && target > 0 && j < bytes.size(); j++) {
+		long slices = (bytes[j] + target - 1) / target;
+		if (slices > ret[j]) ret[j] = (int)slices;
+	}
+	return ret;
+}
+
+/*
+ * to split map tasks in [firstTask, lastTask) into at most slices contiguous ranges,
+ * each of which wrote about the same bytes of the partition.
+ * starts holds the first task of each range.
+ */
+void MapStatus::splitTasks(vector<MapStatus> &statuses, int partition, int firstTask, int lastTask,
+		int slices, vector<int> &starts) {
+	long total = 0;
+	for (int i = firstTask; i < lastTask; i++) {
+		if (partition < (int)statuses[i].bytes.size()) total += statuses[i].bytes[partition];
+	}
+	if (total <= 0) {
+		starts.push_back(firstTask);
+		return;
+	}
+
+	long sum = 0;
+	for (int i = firstTask; i < lastTask; i++) {
+		if (starts.size() == 0 || sum * slices >= total * (long)starts.size()) {
+			starts.push_back(i);
+		}
+		if (partition < (int)statuses[i].bytes.size()) sum += statuses[i].bytes[partition];
+	}
+}
+
+/*
+ * to find hosts holding the largest shares of map output of new partitions in [firstPartition, lastPartition),
+ * written by map tasks in taskRanges, or by all map tasks if taskRanges is empty.
+ * hosts holding at least XYZ_SHUFFLE_LOCALITY_FRACTION of the bytes are returned, the largest share first.
+ */
+vector<string> MapStatus::preferredHosts(vector<MapStatus> &statuses,
+		int firstPartition, int lastPartition, const vector< pair<int, int> > &taskRanges) {
+	vector<string> ret;
+	if (XYZ_SHUFFLE_LOCALITY_MODE != 1) return ret;
+
+	vector< pair<int, int> > ranges = taskRanges;
+	if (ranges.size() == 0) ranges.push_back(make_pair(0, (int)statuses.size()));
+
+	map<string, long> hostBytes;
+	long total = 0;
+	for (size_t r = 0; r < ranges.size(); r++) {
+		for (int i = ranges[r].first; i < ranges[r].second && i < (int)statuses.size(); i++) {
+			for (int j = firstPartition; j < lastPartition && j < (int)statuses[i].bytes.size(); j++) {
+				hostBytes[statuses[i].host] += statuses[i].bytes[j];
+				total += statuses[i].bytes[j];
+			}
+		}
+	}
+	if (total <= 0) return ret;
+
+	vector< pair<long, string> > shares;
+	map<string, long>::iterator it;
+	for (it = hostBytes.begin(); it != hostBytes.end(); ++it) {
+		if (it->second >= XYZ_SHUFFLE_LOCALITY_FRACTION * total) {
+			shares.push_back(make_pair(-it->second, it->first)); // largest first, then by host
+		}
+	}
+	std::sort(shares.begin(), shares.end());
+	for (size_t i = 0; i < shares.size(); i++) {
+		ret.push_back(shares[i].second);
+	}
+	return ret;
+}
+
+#endif /* INCLUDE_MAPSTATUS_HPP_ */
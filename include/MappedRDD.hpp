@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
 #include "Partition.hpp"
 #include "RDD.hpp"
 using namespace std;
@@ -57,7 +58,39 @@ vector<Partition*> MappedRDD<U, T>::getPartitions()
 template <class U, class T>
 vector<string> MappedRDD<U, T>::preferredLocations(Partition *p)
 {
-	return prevRDD->preferredLocations(p);
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class U, class T>
+void MappedRDD<U, T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<U>::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class U, class T>
+size_t MappedRDD<U, T>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
+}
+
+/*
+ * mapping keeps the number of values, so values of previous RDD are counted,
+ * without mapping them. a persisted partition is counted from storage.
+ */
+template <class U, class T>
+size_t MappedRDD<U, T>::countPartition(Partition *p)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD<U>::countPartition(p);
+	}
+	return prevRDD->countPartition(p);
 }
 
 /*
@@ -67,10 +100,37 @@ vector<string> MappedRDD<U, T>::preferredLocations(Partition *p)
 template <class U, class T>
 IteratorSeq<U> * MappedRDD<U, T>::iteratorSeq(Partition *p)
 {
-	IteratorSeq<U> *ret = prevRDD->iteratorSeq(p)->map(mappedFunction);
+	IteratorSeq<U> *ret = prevRDD->getOrCompute(p)->map(mappedFunction);
 	this->addIteratorSeq(ret); // for garbage collection
 	return ret;
 }
 
+/*
+ * to map and filter the data set in the partition in one pass,
+ * so values failing the filter are never kept.
+ * a persisted partition is filtered from storage instead.
+ */
+template <class U, class T>
+IteratorSeq<U> * MappedRDD<U, T>::filteredIteratorSeq(Partition *p, bool (*f)(U&),
+		double selectivity, size_t &count)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD<U>::filteredIteratorSeq(p, f, selectivity, count);
+	}
+
+	IteratorSeq<T> *seq = prevRDD->getOrCompute(p);
+	count = seq->size();
+	VectorIteratorSeq<U> *ret = new VectorIteratorSeq<U>();
+	ret->reserve(selectivity < 0 ? 0 : (size_t)(count * selectivity));
+	for(size_t i = 0; i < count; i++) {
+		T t = seq->at(i);
+		U u = mappedFunction(t);
+		if(f(u)) {
+			ret->push_back(u);
+		}
+	}
+	return ret;
+}
+
 
 #endif /* MAPPEDRDD_HPP_ */
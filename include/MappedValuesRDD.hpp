@@ -0,0 +1,130 @@
+/*
+ * MappedValuesRDD.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INCLUDE_MAPPEDVALUESRDD_HPP_
+#define INCLUDE_MAPPEDVALUESRDD_HPP_
+
+#include "MappedValuesRDD.h"
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "HashDivider.hpp"
+
+/*
+ * constructor, accepting previous RDD and the function mapping values
+ */
+template <class K, class U, class V>
+MappedValuesRDD<K, U, V>::MappedValuesRDD(RDD< Pair<K, V> > *prev, U (*f)(V&))
+:RDD< Pair<K, U> >::RDD(prev->context), prevRDD(prev)
+{
+	mappedFunction = f;
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class K, class U, class V>
+MappedValuesRDD<K, U, V>::~MappedValuesRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * shuffle the previous RDD, this MappedValuesRDD does not need to shuffle
+ */
+template <class K, class U, class V>
+void MappedValuesRDD<K, U, V>::shuffle()
+{
+	prevRDD->shuffle();
+}
+
+/*
+ * get partitions of this RDD, which are from its previous RDD.
+ */
+template <class K, class U, class V>
+vector<Partition*> MappedValuesRDD<K, U, V>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get the preferred locations of the partition.
+ * mapping does not change the preferred locations of partitions
+ */
+template <class K, class U, class V>
+vector<string> MappedValuesRDD<K, U, V>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class K, class U, class V>
+void MappedValuesRDD<K, U, V>::partitionScheduled(Partition *p, string host)
+{
+	RDD< Pair<K, U> >::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class K, class U, class V>
+size_t MappedValuesRDD<K, U, V>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
+}
+
+/*
+ * mapping keeps the number of values, so values of previous RDD are counted,
+ * without mapping them. a persisted partition is counted from storage.
+ */
+template <class K, class U, class V>
+size_t MappedValuesRDD<K, U, V>::countPartition(Partition *p)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD< Pair<K, U> >::countPartition(p);
+	}
+	return prevRDD->countPartition(p);
+}
+
+/*
+ * keys are not changed, so the partitioner of previous RDD holds.
+ */
+template <class K, class U, class V>
+HashDivider * MappedValuesRDD<K, U, V>::getPartitioner()
+{
+	return prevRDD->getPartitioner();
+}
+
+/*
+ * get the data set in the partition.
+ * each pair keeps its key, with its value mapped.
+ */
+template <class K, class U, class V>
+IteratorSeq< Pair<K, U> > * MappedValuesRDD<K, U, V>::iteratorSeq(Partition *p)
+{
+	IteratorSeq< Pair<K, V> > *seq = prevRDD->getOrCompute(p);
+	size_t size = seq->size();
+	VectorIteratorSeq< Pair<K, U> > *ret = new VectorIteratorSeq< Pair<K, U> >();
+	ret->reserve(size);
+	for(size_t i = 0; i < size; i++) {
+		Pair<K, V> pair = seq->at(i);
+		U u = mappedFunction(pair.v2);
+		ret->push_back(Pair<K, U>(pair.v1, u));
+	}
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+
+#endif /* INCLUDE_MAPPEDVALUESRDD_HPP_ */
@@ -0,0 +1,163 @@
+/*
+ * MemoryGovernor.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_MEMORYGOVERNOR_HPP_
+#define INCLUDE_MEMORYGOVERNOR_HPP_
+
+#include "MemoryGovernor.h"
+
+#include <algorithm>
+
+// the memory governor of this node.
+// defined with its constructor, as headers are included by programs never linking it.
+MemoryGovernor XYZ_MEMORY_GOVERNOR;
+
+/*
+ * destructor
+ */
+MemoryConsumer::~MemoryConsumer() {
+
+}
+
+/*
+ * constructor, with no limit until the budget is set
+ */
+MemoryGovernor::MemoryGovernor()
+: budget(0), reserved(0), acquired(0) {
+	pthread_mutex_init(&mutex, NULL);
+}
+
+/*
+ * destructor
+ */
+MemoryGovernor::~MemoryGovernor() {
+	pthread_mutex_destroy(&mutex);
+}
+
+/*
+ * to set the memory budget of this node in bytes, 0 for no limit
+ */
+void MemoryGovernor::setBudget(size_t bytes) {
+	pthread_mutex_lock(&mutex);
+	budget = bytes;
+	pthread_mutex_unlock(&mutex);
+}
+
+/*
+ * to get the memory budget of this node in bytes
+ */
+size_t MemoryGovernor::getBudget() {
+	return budget;
+}
+
+/*
+ * to get memory reserved by running tasks and acquired by kept data
+ */
+size_t MemoryGovernor::getUsed() {
+	pthread_mutex_lock(&mutex);
+	size_t used = reserved + acquired;
+	pthread_mutex_unlock(&mutex);
+	return used;
+}
+
+/*
+ * to reserve memory for a task to run.
+ * return false if the budget would be exceeded even after spilling,
+ * then the task should wait for running tasks to release memory.
+ * a task is forced when no other task is running, so it runs anyway.
+ */
+bool MemoryGovernor::reserve(size_t bytes, bool force) {
+	pthread_mutex_lock(&mutex);
+	if(!fits(bytes)) {
+		spill(bytes, force);
+	}
+	bool ret = force || fits(bytes);
+	if(ret) {
+		reserved += bytes;
+	}
+	pthread_mutex_unlock(&mutex);
+	return ret;
+}
+
+/*
+ * to release memory reserved by a finished task
+ */
+void MemoryGovernor::release(size_t bytes) {
+	pthread_mutex_lock(&mutex);
+	reserved -= std::min(bytes, reserved);
+	pthread_mutex_unlock(&mutex);
+}
+
+/*
+ * to acquire memory for data kept after a task.
+ * return false if the budget would be exceeded even after spilling,
+ * then the data should be written to disk or dropped.
+ */
+bool MemoryGovernor::acquire(size_t bytes) {
+	pthread_mutex_lock(&mutex);
+	if(!fits(bytes)) {
+		spill(bytes, false);
+	}
+	bool ret = fits(bytes);
+	if(ret) {
+		acquired += bytes;
+	}
+	pthread_mutex_unlock(&mutex);
+	return ret;
+}
+
+/*
+ * to release memory of data no longer kept
+ */
+void MemoryGovernor::releaseAcquired(size_t bytes) {
+	pthread_mutex_lock(&mutex);
+	acquired -= std::min(bytes, acquired);
+	pthread_mutex_unlock(&mutex);
+}
+
+/*
+ * to add a consumer to ask for spilling.
+ * it must release acquired memory by spill, not releaseAcquired, when asked.
+ */
+void MemoryGovernor::addConsumer(MemoryConsumer *c) {
+	pthread_mutex_lock(&mutex);
+	consumers.push_back(c);
+	pthread_mutex_unlock(&mutex);
+}
+
+/*
+ * to remove a consumer.
+ * it waits for spilling in progress, so the consumer can be deleted then.
+ */
+void MemoryGovernor::removeConsumer(MemoryConsumer *c) {
+	pthread_mutex_lock(&mutex);
+	vector<MemoryConsumer *>::iterator it = find(consumers.begin(), consumers.end(), c);
+	if(it != consumers.end()) {
+		consumers.erase(it);
+	}
+	pthread_mutex_unlock(&mutex);
+}
+
+/*
+ * whether bytes more fit in the budget
+ */
+bool MemoryGovernor::fits(size_t bytes) {
+	return budget == 0 || reserved + acquired + bytes <= budget;
+}
+
+/*
+ * to ask consumers to spill, until bytes more fit in the budget.
+ * idle if no task is running, as a task is only forced to reserve then.
+ */
+void MemoryGovernor::spill(size_t bytes, bool idle) {
+	for(size_t i = 0; i < consumers.size() && !fits(bytes); i++) {
+		size_t need = reserved + acquired + bytes - budget;
+		size_t freed = consumers[i]->spill(need, idle);
+		acquired -= std::min(freed, acquired);
+	}
+}
+
+#endif /* INCLUDE_MEMORYGOVERNOR_HPP_ */
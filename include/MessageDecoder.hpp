@@ -0,0 +1,82 @@
+/*
+ * MessageDecoder.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_MESSAGEDECODER_HPP_
+#define INCLUDE_MESSAGEDECODER_HPP_
+
+#include "MessageDecoder.h"
+
+#include <algorithm>
+
+/*
+ * destructor
+ */
+MessageDecoder::~MessageDecoder() {
+
+}
+
+/*
+ * constructor
+ */
+RecordDecoder::RecordDecoder(string delimitation)
+: delimitation(delimitation) {
+}
+
+/*
+ * to split received bytes into records.
+ * records received completely in a chunk are copied from the chunk into one reused buffer,
+ * only a record split between chunks is kept in pending.
+ * a delimitation may be split between chunks too, so searching starts before the new bytes.
+ */
+void RecordDecoder::decode(const char *data, size_t size) {
+	const char *end = data + size;
+	size_t start = 0; // first byte of data not decoded
+
+	if(pending.size() > 0) {
+		// a delimitation beginning in pending ends in the first bytes of data
+		size_t old = pending.size();
+		size_t from = old >= delimitation.size() ? old - delimitation.size() + 1 : 0;
+		pending.append(data, size < delimitation.size() - 1 ? size : delimitation.size() - 1);
+		size_t pos = pending.find(delimitation, from);
+		if(pos != string::npos) {
+			pending.resize(pos);
+			record(pending);
+			start = pos + delimitation.size() - old;
+		}
+		else {
+			pending.resize(old);
+			const char *found = std::search(data, end, delimitation.begin(), delimitation.end());
+			if(found == end) {
+				pending.append(data, size);
+				return;
+			}
+			pending.append(data, found - data);
+			record(pending);
+			start = found - data + delimitation.size();
+		}
+		pending.clear();
+	}
+
+	const char *found;
+	while((found = std::search(data + start, end, delimitation.begin(), delimitation.end())) != end) {
+		current.assign(data + start, found - data - start);
+		record(current);
+		start = found - data + delimitation.size();
+	}
+	pending.assign(data + start, end - data - start);
+}
+
+/*
+ * the last record has no delimitation after it
+ */
+void RecordDecoder::finish() {
+	if(pending.size() > 0) {
+		record(pending);
+	}
+	pending.clear();
+}
+
+#endif /* INCLUDE_MESSAGEDECODER_HPP_ */
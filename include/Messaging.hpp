@@ -21,6 +21,8 @@
 #include "MessageType.hpp"
 #include "Utils.hpp"
 #include "Logging.hpp"
+#include "CacheManager.hpp"
+#include "MessageDecoder.hpp"
 #include "SunwayMRContext.h"
 using namespace std;
 
@@ -29,7 +31,7 @@ using namespace std;
  */
 Messaging::Messaging() {
 	listenStatus = NA;
-	pthread_mutex_init(&mutex_check_file_cache, NULL);
+	pthread_mutex_init(&mutex_shuffle_push, NULL);
 }
 
 /*
@@ -46,10 +48,28 @@ Messaging::~Messaging()
  * save shuffle cache
  */
 void Messaging::saveShuffleCache(long shuffleID, DataCache *cache) {
-	if(this->shuffle_cache.find(shuffleID) == this->shuffle_cache.end()) {
-		this->shuffle_cache[shuffleID] = vector< DataCache * >();
-	}
-	this->shuffle_cache[shuffleID].push_back(cache);
+	this->cacheManager.saveShuffle(shuffleID, cache);
+}
+
+/*
+ * stop serving shuffle cache, called before the cache is destroyed
+ */
+void Messaging::releaseShuffleCache(long shuffleID) {
+	this->cacheManager.releaseShuffle(shuffleID);
+}
+
+/*
+ * a file will be read by FILE_BLOCK_REQUEST, keep it cached until released
+ */
+void Messaging::retainFileCache(string path) {
+	this->cacheManager.retainFile(path);
+}
+
+/*
+ * a file will not be read anymore
+ */
+void Messaging::releaseFileCache(string path) {
+	this->cacheManager.releaseFile(path);
 }
 
 /*
@@ -64,52 +84,84 @@ void Messaging::clearAllCache() {
  * clear file cache, both cache read by byte and cache read by line
  */
 void Messaging::clearFileCache() {
-	// file content
-	map<string, string* >::iterator it1;
-	for(it1=file_cache_bytes.begin(); it1!=file_cache_bytes.end(); ++it1) {
-		delete it1->second;
-	}
-	file_cache_bytes.clear();
-
-	map<string, vector<string>* >::iterator it2;
-	for(it2=file_cache_lines.begin(); it2!=file_cache_lines.end(); ++it2) {
-		delete it2->second;
-	}
-	file_cache_lines.clear();
+	this->cacheManager.clearFiles();
 }
 
 /*
- * clear shuffle cache
+ * clear shuffle cache.
+ * the cache itself is owned and deleted by shuffled RDDs.
  */
 void Messaging::clearShuffleCache() {
-	// shuffle cache is cleared by ShuffledRDD now
+	this->cacheManager.clearShuffles();
+}
+
+/*
+ * read message from a socket file descriptor, append the message to ret
+ */
+void appendSocket(int socketfd, string &ret) {
+	vector<char> buffer(XYZ_MESSAGING_CHUNK_SIZE);
+	while (true) {
+		ssize_t received = recv(socketfd, &buffer[0], buffer.size(), 0);
+		if (received < 0 && errno == EINTR) continue;
+		if (received <= 0) break;
+		ret.append(&buffer[0], received);
+	}
 }
 
 /*
  * read message from a socket file descriptor, save the message to the second parameter ret
  */
 void readSocket(int socketfd, string &ret) {
-	//int MAX_MESSAGE_SIZE = 1024 * 1024 * 1024; // TODO configuration out of code
-	int BUFFER_SIZE = 1024 * 1024 * 4; // receive buffer TODO configuration out of code
+	ret.clear();
+	appendSocket(socketfd, ret);
+}
 
-	char buffer[BUFFER_SIZE];
-	ssize_t total = 0;
-	vector<string> strs;
+/*
+ * read message from a socket file descriptor chunk by chunk, each chunk is decoded at once.
+ * return bytes received.
+ */
+size_t readSocket(int socketfd, MessageDecoder &decoder) {
+	vector<char> buffer(XYZ_MESSAGING_CHUNK_SIZE);
+	size_t total = 0;
 	while (true) {
-		memset(buffer, 0, BUFFER_SIZE);
-		ssize_t received = recv(socketfd, buffer, BUFFER_SIZE - 1, 0);
-
-		if(received <= 0) break;
-
+		ssize_t received = recv(socketfd, &buffer[0], buffer.size(), 0);
+		if (received < 0 && errno == EINTR) continue;
+		if (received <= 0) break;
 		total += received;
-		strs.push_back(buffer);
+		decoder.decode(&buffer[0], received);
 	}
+	return total;
+}
+
+/*
+ * read message from a socket file descriptor until c is received, append the message to ret.
+ * return position of c in ret, string::npos if the message ends before c.
+ */
+string::size_type readSocketUntil(int socketfd, string &ret, char c) {
+	vector<char> buffer(1024);
+	while (true) {
+		string::size_type pos = ret.find(c);
+		if (pos != string::npos) return pos;
 
-	ret = "";
-	for(unsigned int i = 0; i < strs.size(); i++) {
-		ret += strs[i];
+		ssize_t received = recv(socketfd, &buffer[0], buffer.size(), 0);
+		if (received < 0 && errno == EINTR) continue;
+		if (received <= 0) return string::npos;
+		ret.append(&buffer[0], received);
 	}
+}
 
+/*
+ * write all of data to a socket, send may write part of it only
+ */
+bool sendAll(int socket_fd, const char *data, size_t size) {
+	while (size > 0) {
+		ssize_t sent = send(socket_fd, data, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) continue;
+		if (sent <= 0) return false;
+		data += sent;
+		size -= sent;
+	}
+	return true;
 }
 
 /*
@@ -127,9 +179,9 @@ bool sendEndOfMessage(int socket_fd) {
 }
 
 /*
- * the internal sending function
+ * to connect to address, and send message type
  */
-bool Messaging::sendMessageInternal(int socket_fd, string addr, int targetPort, int msgType, string &msg) {
+bool Messaging::connectMessage(int socket_fd, string addr, int targetPort, int msgType) {
 	struct sockaddr_in address;
 	bzero(&address, sizeof(address));
 	address.sin_family = AF_INET;
@@ -149,22 +201,33 @@ bool Messaging::sendMessageInternal(int socket_fd, string addr, int targetPort,
 		}
 	}
 
-	// organizing message
+	// message type comes first
 	char buffer [33];
 	memset(buffer, 0, sizeof(buffer));
 	snprintf(buffer, sizeof(buffer), "%d$", msgType);
-	string content = buffer;
-	content += msg;
+	if (!sendAll(socket_fd, buffer, strlen(buffer)))
+	{
+		Logging::logError("Messaging: sendMessageInternal: failed to send");
+		return false;
+	}
+	return true;
+}
+
+/*
+ * the internal sending function
+ */
+bool Messaging::sendMessageInternal(int socket_fd, string addr, int targetPort, int msgType, string &msg) {
+	if (!connectMessage(socket_fd, addr, targetPort, msgType)) {
+		return false;
+	}
 
 	// send data
-	const char* ch1 = content.c_str();
-	int ret = send(socket_fd, ch1, content.length(), 0);
-	if (ret < 0)
+	if (!sendAll(socket_fd, msg.data(), msg.size()))
 	{
 		Logging::logError("Messaging: sendMessageInternal: failed to send");
 		return false;
 	}
-	ret = shutdown(socket_fd, SHUT_WR); // shutdown the data transmission
+	int ret = shutdown(socket_fd, SHUT_WR); // shutdown the data transmission
 	if (ret < 0)
 	{
 		Logging::logError("Messaging: sendMessageInternal: failed to shutdown!");
@@ -173,6 +236,40 @@ bool Messaging::sendMessageInternal(int socket_fd, string addr, int targetPort,
 	return true;
 }
 
+/*
+ * to begin a message to be written by ChunkedWriter.
+ * return the socket, -1 if failed.
+ */
+int Messaging::beginMessage(string addr, int targetPort, int msgType) {
+	int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+	if (sockfd < 0) {
+		Logging::logError("Messaging::beginMessage: failed to initialize socket");
+		return -1;
+	}
+	if (!connectMessage(sockfd, addr, targetPort, msgType)) {
+		close(sockfd);
+		return -1;
+	}
+	return sockfd;
+}
+
+/*
+ * to finish a message begun by beginMessage, and wait a reply.
+ * the socket is closed.
+ */
+bool Messaging::endMessage(int socket_fd) {
+	string reply;
+	if (shutdown(socket_fd, SHUT_WR) == 0) {
+		readSocket(socket_fd, reply);
+	}
+	close(socket_fd);
+	if (reply == "") {
+		Logging::logError("Messaging::endMessage: no reply");
+		return false;
+	}
+	return true;
+}
+
 /*
  * send message and wait a reply
  */
@@ -226,6 +323,48 @@ bool Messaging::sendMessageForReply(string addr, int targetPort, int msgType, st
 	return ret;
 }
 
+/*
+ * send message and decode the reply while it is received.
+ * decoder is finished after the reply.
+ */
+bool Messaging::sendMessageForReply(string addr, int targetPort, int msgType, string &msg, MessageDecoder &decoder)
+{
+	int empty_reply_time = 0;
+	int empty_reply_time_max = 100;
+	while(empty_reply_time < empty_reply_time_max) {
+		int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+		if (sockfd < 0)
+		{
+			Logging::logError("Messaging::sendMessageForReply: failed to initialize socket");
+			return false;
+		}
+		if(!sendMessageInternal(sockfd, addr, targetPort, msgType, msg)) {
+			close(sockfd);
+			return false;
+		}
+
+		// decode replied data, an empty reply is not decoded at all
+		size_t received = readSocket(sockfd, decoder);
+		close(sockfd);
+		if(received == 0) { // failed
+			empty_reply_time++;
+			usleep(300000 + rand()%300000); // sleep & reconnect later
+			continue;
+		}
+		decoder.finish();
+		return true;
+	}
+
+	char buffer[256];
+	memset(buffer, 0, sizeof(buffer));
+	snprintf(buffer,
+			sizeof(buffer),
+			"Messaging::sendMessageForReply: failed to send after recv %d empty reply",
+			empty_reply_time_max);
+	Logging::logError(buffer);
+	return false;
+}
+
 /*
  * send message
  */
@@ -240,6 +379,64 @@ bool Messaging::sendMessage(string addr, int targetPort, int msgType, string &ms
 	return true;
 }
 
+/*
+ * to fetch shuffle data of a partition from other hosts, decoded while received.
+ * only data written by map tasks in [firstTask, lastTask) if firstTask >= 0.
+ */
+void Messaging::fetchShuffleData(vector<string> &hosts, int targetPort,
+		long shuffleID, int partitionID, int firstTask, int lastTask, MessageDecoder &decoder)
+{
+	string self = getLocalHost();
+	string sendMsg = num2string(shuffleID) + "," + num2string(partitionID); //organize request
+	if(firstTask >= 0) {
+		sendMsg += "," + num2string(firstTask) + "," + num2string(lastTask);
+	}
+	for(unsigned int i=0; i<hosts.size(); i++)
+	{
+		if(hosts[i] == self) continue;
+		sendMessageForReply(hosts[i], targetPort, FETCH_REQUEST, sendMsg, decoder);
+	}
+}
+
+/*
+ * save shuffle data of a partition pushed by a map task on another host
+ */
+void Messaging::savePushedShuffleData(long shuffleID, long taskID, int partitionID, string &data) {
+	pthread_mutex_lock(&mutex_shuffle_push);
+	shuffle_push_cache[shuffleID][partitionID][taskID].swap(data);
+	pthread_mutex_unlock(&mutex_shuffle_push);
+}
+
+/*
+ * to move pushed data of a partition to blocks, by IDs of the map tasks which pushed it.
+ */
+void Messaging::takePushedShuffleData(long shuffleID, int partitionID, map<long, string> &blocks) {
+	pthread_mutex_lock(&mutex_shuffle_push);
+	map< long, map< int, map<long, string> > >::iterator it = shuffle_push_cache.find(shuffleID);
+	if(it != shuffle_push_cache.end() && it->second.find(partitionID) != it->second.end()) {
+		blocks.swap(it->second[partitionID]);
+		it->second.erase(partitionID);
+	}
+	pthread_mutex_unlock(&mutex_shuffle_push);
+}
+
+/*
+ * clear pushed data of a shuffle
+ */
+void Messaging::clearPushedShuffleData(long shuffleID) {
+	pthread_mutex_lock(&mutex_shuffle_push);
+	shuffle_push_cache.erase(shuffleID);
+	pthread_mutex_unlock(&mutex_shuffle_push);
+}
+
+/*
+ * a sub-class may decode messages of some types while they are received.
+ * return NULL to receive whole messages by messageReceived.
+ */
+MessageDecoder * Messaging::createDecoder(int localListenPort, string fromHost, int msgType) {
+	return NULL;
+}
+
 /*
  * to create a server socket and listen on the port.
  * this function shall be called in another thread if the main thread need do other work
@@ -324,20 +521,80 @@ int Messaging::getListenStatus() {
  * just write the msg to a socket
  */
 void send(int socket_fd, string &msg) {
-	int rsend = 0;
+	bool sent = false;
 	if(msg == "") {
 		string empty_msg = EMPTY_MESSAGE;
-		rsend = send(socket_fd, empty_msg.c_str(), empty_msg.length(), 0);
+		sent = sendAll(socket_fd, empty_msg.c_str(), empty_msg.length());
 	}
 	else {
-		rsend = send(socket_fd, msg.c_str(), msg.length(), 0);
+		sent = sendAll(socket_fd, msg.data(), msg.length());
 	}
-	if (rsend < 0) {
+	if (!sent) {
 		// send failed
 		Logging::logError("Messaging::messageHandler: reply FILE_BLOCK_REQUEST, failed to send");
 	}
 }
 
+/*
+ * constructor of ChunkedWriter to a socket
+ */
+ChunkedWriter::ChunkedWriter(int socket_fd)
+: socket_fd(socket_fd), total(0), error(false) {
+	chunk.reserve(XYZ_MESSAGING_CHUNK_SIZE);
+}
+
+/*
+ * to copy data into the chunk, sending the chunk whenever it is full
+ */
+void ChunkedWriter::write(const char *data, size_t size) {
+	total += size;
+	while (size > 0) {
+		size_t n = XYZ_MESSAGING_CHUNK_SIZE - chunk.size();
+		if (n > size) n = size;
+		chunk.append(data, n);
+		data += n;
+		size -= n;
+		if (chunk.size() >= XYZ_MESSAGING_CHUNK_SIZE) flush();
+	}
+}
+
+void ChunkedWriter::write(const string &s) {
+	write(s.data(), s.size());
+}
+
+/*
+ * to copy data of a cache into the chunk piece by piece
+ */
+void ChunkedWriter::write(DataCache *cache, long dataIndex) {
+	size_t size = cache->getDataSize(dataIndex);
+	total += size;
+	for (size_t offset = 0; offset < size; ) {
+		size_t n = XYZ_MESSAGING_CHUNK_SIZE - chunk.size();
+		cache->appendData(dataIndex, offset, n, chunk);
+		offset += n;
+		if (chunk.size() >= XYZ_MESSAGING_CHUNK_SIZE) flush();
+	}
+}
+
+/*
+ * to send the chunk to the socket
+ */
+bool ChunkedWriter::flush() {
+	if (chunk.size() > 0 && !sendAll(socket_fd, chunk.data(), chunk.size())) {
+		error = true;
+	}
+	chunk.clear();
+	return !error;
+}
+
+size_t ChunkedWriter::written() {
+	return total;
+}
+
+bool ChunkedWriter::failed() {
+	return error;
+}
+
 /*
  * thread function for socket connection handling
  */
@@ -348,14 +605,29 @@ void* messageHandler(void *data)
 	Messaging *m = td->mess;
 
 	string msg;
-	readSocket(td->client_sockfd, msg); // read data from socket
+	string::size_type pos = readSocketUntil(td->client_sockfd, msg, '$'); // read message type
+	MessageDecoder *decoder = NULL;
+	if (pos != string::npos) {
+		decoder = m->createDecoder(td->local_port, td->ip, atoi(msg.substr(0, pos).c_str()));
+	}
+
+	if (decoder != NULL) { // decode the message while it is received
+		decoder->decode(msg.data() + pos + 1, msg.size() - pos - 1);
+		string().swap(msg);
+		readSocket(td->client_sockfd, *decoder);
+
+		// reply as soon as received, the receiver may exit once the message is handled
+		string reply = "";
+		send(td->client_sockfd, reply);
+		close(td->client_sockfd);
 
-	string::size_type pos;
-	pos=msg.find('$', 0);
-	if (pos !=  string::npos) {
+		decoder->finish();
+		delete decoder;
+	} else if (pos !=  string::npos) {
+		appendSocket(td->client_sockfd, msg); // read data from socket
 		string typeStr = msg.substr(0, pos);
 		int msgType = atoi(typeStr.c_str()); // message type
-		string msgContent=msg.substr(pos+1);
+		string &msgContent = msg.erase(0, pos + 1);
 
 		if(msgType == FILE_BLOCK_REQUEST) { // the socket is requesting a file block
 			vector<string> vs;
@@ -367,29 +639,9 @@ void* messageHandler(void *data)
 				int length = atoi(vs[2].c_str()); // requested length
 				FileSourceFormat format = static_cast<FileSourceFormat>(atoi(vs[3].c_str()));
 				if (format == FILE_SOURCE_FORMAT_BYTE) { // requesting bytes data
-					pthread_mutex_lock(&m->mutex_check_file_cache);
-					if (m->file_cache_bytes.find(path) == m->file_cache_bytes.end()) { // check file cache
-						string *file_content = new string();
-						readFile(path, *file_content); // read file by byte
-						m->file_cache_bytes[path] = file_content; // save file content in cache
-					} 
-					pthread_mutex_unlock(&m->mutex_check_file_cache);
-
-					ret = m->file_cache_bytes[path]->substr(offset, length);
+					m->cacheManager.readFileBytes(path, offset, length, ret);
 				} else { // requesting lines of content
-					pthread_mutex_lock(&m->mutex_check_file_cache);
-					if (m->file_cache_lines.find(path) == m->file_cache_lines.end()) { // check file cache
-						vector<string> *file_content = new vector<string>();
-						readFileToLines(path, *file_content); // read file
-						m->file_cache_lines[path] = file_content; // save cache in memory
-					} 
-					pthread_mutex_unlock(&m->mutex_check_file_cache);
-
-					unsigned end_line = offset+length;
-					for (unsigned int i=offset; i<end_line && i<m->file_cache_lines[path]->size(); i++) {
-						ret += (*m->file_cache_lines[path])[i];
-						ret += "\n";
-					}
+					m->cacheManager.readFileLines(path, offset, length, ret);
 				}
 				send(td->client_sockfd, ret);
 				close(td->client_sockfd);
@@ -397,31 +649,54 @@ void* messageHandler(void *data)
 		} else if(msgType == FETCH_REQUEST) {
 			vector<string> paras;
 			splitString(msgContent, paras, ",");
-			if(paras.size() == 2)
+			if(paras.size() == 2 || paras.size() == 4)
 			{
 				long shuffleID = atol(paras[0].c_str());
 				int partitionID = atoi(paras[1].c_str());
 
-				// organize message
-				string senMsg;
-				if(m->shuffle_cache.find(shuffleID) != m->shuffle_cache.end()
-						&& m->shuffle_cache[shuffleID].size() > 0)
+				// stream serialized blocks of cached tasks in chunks, skipping empty ones
+				ChunkedWriter writer(td->client_sockfd);
+				vector<DataCache *> *cached = m->cacheManager.acquireShuffle(shuffleID);
+				if(cached != NULL)
 				{
-					string data;
-					for(unsigned int i=0; i < m->shuffle_cache[shuffleID].size() - 1; i++) {
-						data = "";
-						m->shuffle_cache[shuffleID][i]->getData(partitionID, data);
-						senMsg += data;
-						senMsg += string(SHUFFLETASK_KV_DELIMITATION);
+					vector<DataCache *> &caches = *cached;
+					const string delimitation = SHUFFLETASK_KV_DELIMITATION;
+					unsigned int first = 0, last = caches.size(); // range of map tasks
+					if(paras.size() == 4) {
+						first = atoi(paras[2].c_str());
+						last = atoi(paras[3].c_str());
+						if(last > caches.size()) last = caches.size();
 					}
-					data = "";
-					m->shuffle_cache[shuffleID].back()->getData(partitionID, data);
-					senMsg += data;
+					for(unsigned int i=first; i < last; i++) {
+						if(caches[i]->getDataSize(partitionID) == 0) continue;
+						if(writer.written() > 0) writer.write(delimitation);
+						writer.write(caches[i], partitionID);
+					}
+					m->cacheManager.releaseShuffleReader(shuffleID);
+				}
+				if(writer.written() == 0) {
+					writer.write(EMPTY_MESSAGE);
+				}
+				if(!writer.flush()) {
+					Logging::logError("Messaging::messageHandler: reply FETCH_REQUEST, failed to send");
+				}
+			}
+			close(td->client_sockfd);
+		} else if(msgType == SHUFFLE_PUSH) {
+			// save partitions before replying, so the map task finishes after its data arrived
+			vector<string> vs;
+			splitString(msgContent, vs, SHUFFLE_PUSH_DELIMITATION);
+			vector<string> paras;
+			if(vs.size() > 0) splitString(vs[0], paras, ",");
+			if(paras.size() == 2) {
+				long shuffleID = atol(paras[0].c_str());
+				long taskID = atol(paras[1].c_str());
+				for(unsigned int i = 1; i + 1 < vs.size(); i += 2) {
+					m->savePushedShuffleData(shuffleID, taskID, atoi(vs[i].c_str()), vs[i + 1]);
 				}
-
-				// sending back result
-				send(td->client_sockfd, senMsg);
 			}
+			string reply = "";
+			send(td->client_sockfd, reply);
 			close(td->client_sockfd);
 		} else if(msgType == FILE_INFO || msgType > 999999) { // file transmission of sunwaymrhelper
 			m->messageReceived(td->local_port, td->ip, msgType, msgContent);
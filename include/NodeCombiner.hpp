@@ -0,0 +1,149 @@
+/*
+ * NodeCombiner.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_NODECOMBINER_HPP_
+#define INCLUDE_NODECOMBINER_HPP_
+
+#include "NodeCombiner.h"
+
+#include "DataCache.hpp"
+#include "Aggregator.hpp"
+#include "FlatCombinerMap.hpp"
+#include "Pair.hpp"
+#include "Task.hpp"
+
+/*
+ * constructor
+ */
+template <class K, class V, class C>
+NodeCombiner<K, V, C>::NodeCombiner(int nPs, Aggregator< Pair<K, V>, Pair<K, C> > &aggregator,
+		string (*sf)(Pair<K, C> &p))
+: numPartitions(nPs), agg(aggregator), strFunc(sf), combiners(nPs), mutexes(nPs), finished(false)
+{
+	for(int i = 0; i < numPartitions; i++) {
+		pthread_mutex_init(&mutexes[i], NULL);
+	}
+	pthread_mutex_init(&finishMutex, NULL);
+}
+
+/*
+ * destructor
+ */
+template <class K, class V, class C>
+NodeCombiner<K, V, C>::~NodeCombiner()
+{
+	for(int i = 0; i < numPartitions; i++) {
+		pthread_mutex_destroy(&mutexes[i]);
+	}
+	pthread_mutex_destroy(&finishMutex);
+}
+
+/*
+ * to merge combiners of a new partition, output by a map task.
+ * called by map tasks concurrently, before any data is requested.
+ */
+template <class K, class V, class C>
+void NodeCombiner<K, V, C>::merge(int part, vector< Pair<K, C> > &pairs)
+{
+	pthread_mutex_lock(&mutexes[part]);
+	for(size_t i = 0; i < pairs.size(); i++) {
+		combiners[part].merge(pairs[i], agg);
+	}
+	pthread_mutex_unlock(&mutexes[part]);
+}
+
+/*
+ * to serialize combined partitions, once.
+ * data is requested only after the map stage finished on every node,
+ * so no map task merges any more.
+ */
+template <class K, class V, class C>
+void NodeCombiner<K, V, C>::finish()
+{
+	pthread_mutex_lock(&finishMutex);
+	if(!finished) {
+		const string delimitation = SHUFFLETASK_KV_DELIMITATION;
+		partitions.resize(numPartitions);
+		outputIndex.assign(numPartitions + 1, 0);
+		for(int i = 0; i < numPartitions; i++) {
+			combiners[i].swap(partitions[i]);
+			outputIndex[i] = output.size();
+			for(size_t j = 0; j < partitions[i].size(); j++) {
+				if(j > 0) output += delimitation;
+				output += strFunc(partitions[i][j]);
+			}
+		}
+		outputIndex[numPartitions] = output.size();
+		combiners.clear();
+		finished = true;
+	}
+	pthread_mutex_unlock(&finishMutex);
+}
+
+/*
+ * return combined pairs of a new partition, to be merged by local reduce tasks
+ */
+template <class K, class V, class C>
+vector< Pair<K, C> > & NodeCombiner<K, V, C>::getPartitionData(int part)
+{
+	finish();
+	return partitions[part];
+}
+
+/*
+ * return serialized combiners of requested partition
+ */
+template <class K, class V, class C>
+void NodeCombiner<K, V, C>::getData(long cacheIndex, string &result)
+{
+	if(getDataSize(cacheIndex) > 0) {
+		result.assign(output, outputIndex[cacheIndex],
+				outputIndex[cacheIndex + 1] - outputIndex[cacheIndex]);
+	}
+	else {
+		result = SHUFFLETASK_EMPTY_DELIMITATION;
+	}
+}
+
+/*
+ * return bytes of serialized combiners of requested partition
+ */
+template <class K, class V, class C>
+size_t NodeCombiner<K, V, C>::getDataSize(long cacheIndex)
+{
+	if(cacheIndex < 0 || cacheIndex >= numPartitions) {
+		return 0;
+	}
+	finish();
+	return outputIndex[cacheIndex + 1] - outputIndex[cacheIndex];
+}
+
+/*
+ * append serialized combiners of requested partition to result
+ */
+template <class K, class V, class C>
+void NodeCombiner<K, V, C>::appendData(long cacheIndex, string &result)
+{
+	size_t size = getDataSize(cacheIndex);
+	if(size > 0) {
+		result.append(output, outputIndex[cacheIndex], size);
+	}
+}
+
+/*
+ * append bytes [offset, offset + length) of serialized combiners of requested partition to result
+ */
+template <class K, class V, class C>
+void NodeCombiner<K, V, C>::appendData(long cacheIndex, size_t offset, size_t length, string &result)
+{
+	size_t size = getDataSize(cacheIndex);
+	if(offset < size) {
+		if(length > size - offset) length = size - offset;
+		result.append(output.data() + outputIndex[cacheIndex] + offset, length);
+	}
+}
+
+#endif /* INCLUDE_NODECOMBINER_HPP_ */
@@ -18,23 +18,74 @@
 #include "RDD.hpp"
 #include "Pair.hpp"
 #include "ShuffledRDD.hpp"
+#include "SortedRDD.hpp"
+#include "GroupedRDD.hpp"
+#include "BroadcastJoinRDD.hpp"
+#include "ZippedJoinRDD.hpp"
 #include "Aggregator.hpp"
 #include "HashDivider.hpp"
 #include "Either.hpp"
 #include "MappedRDD.hpp"
+#include "MappedValuesRDD.hpp"
 #include "UnionRDD.hpp"
 #include "StringConversion.hpp"
+#include "CountByKeyTask.hpp"
+#include "SampledByKeyRDD.hpp"
+#include "VectorAutoPointer.hpp"
 
 using namespace std;
 
 /*
- * constructor
+ * do nothing for a Pair.
+ * used when change a RDD<Pair> to a PairRDD
+ */
+template <class K, class V>
+Pair< K, V > xyz_pair_rdd_do_nothing_f(Pair< K, V > &p) {
+	return p;
+}
+
+/*
+ * to tell whether a mapToPair function is xyz_pair_rdd_do_nothing_f,
+ * the only function of pairs known not to change keys.
+ */
+template <class K, class V, class T>
+bool xyz_pair_rdd_is_identity_f(Pair<K, V> (*f)(T&)) {
+	return false;
+}
+
+template <class K, class V>
+bool xyz_pair_rdd_is_identity_f(Pair<K, V> (*f)(Pair<K, V>&)) {
+	return f == xyz_pair_rdd_do_nothing_f<K, V>;
+}
+
+/*
+ * to tell whether a mapToPair function maps pairs of the same key type,
+ * so it may keep keys, though that cannot be known
+ */
+template <class K, class V, class T>
+bool xyz_pair_rdd_maps_pairs_f(Pair<K, V> (*f)(T&)) {
+	return false;
+}
+
+template <class K, class V, class W>
+bool xyz_pair_rdd_maps_pairs_f(Pair<K, V> (*f)(Pair<K, W>&)) {
+	return true;
+}
+
+/*
+ * constructor.
+ * a function of pairs drops the partitioner of previous RDD, unless it is xyz_pair_rdd_do_nothing_f,
+ * which is logged, as mapValues with a function of values would keep it.
  */
 template <class K, class V, class T>
 PairRDD<K, V, T>::PairRDD(RDD<T> *prev, Pair<K, V> (*f)(T&))
 :RDD< Pair<K, V> >::RDD(prev->context), prevRDD(prev)
 {
 	mapToPairFunction = f;
+	if(xyz_pair_rdd_maps_pairs_f(f) && !xyz_pair_rdd_is_identity_f(f) && prev->getPartitioner() != NULL) {
+		Logging::logInfo("PairRDD: pairs of a hash partitioned RDD are mapped by a function which may change keys, "
+				"the partitioner is not kept, use mapValues with a function of values to keep it");
+	}
 }
 
 /*
@@ -57,6 +108,19 @@ void PairRDD<K, V, T>::shuffle()
 	prevRDD->shuffle();
 }
 
+/*
+ * get the partitioner.
+ * the partitioner of previous RDD is kept only if pairs are not mapped.
+ */
+template <class K, class V, class T>
+HashDivider * PairRDD<K, V, T>::getPartitioner()
+{
+	if(xyz_pair_rdd_is_identity_f(mapToPairFunction)) {
+		return prevRDD->getPartitioner();
+	}
+	return NULL;
+}
+
 /*
  * get partitions of this RDD.
  * as to PairRDD, all partitions are form its previous RDD
@@ -73,7 +137,39 @@ vector<Partition*> PairRDD<K, V, T>::getPartitions()
 template <class K, class V, class T>
 vector<string> PairRDD<K, V, T>::preferredLocations(Partition *p)
 {
-	return prevRDD->preferredLocations(p);
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class K, class V, class T>
+void PairRDD<K, V, T>::partitionScheduled(Partition *p, string host)
+{
+	RDD< Pair<K, V> >::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * a partition is computed from the same partition of previous RDD.
+ */
+template <class K, class V, class T>
+size_t PairRDD<K, V, T>::inputBytes(Partition *p)
+{
+	return prevRDD->inputBytes(p);
+}
+
+/*
+ * mapping keeps the number of values, so values of previous RDD are counted,
+ * without mapping them. a persisted partition is counted from storage.
+ */
+template <class K, class V, class T>
+size_t PairRDD<K, V, T>::countPartition(Partition *p)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD< Pair<K, V> >::countPartition(p);
+	}
+	return prevRDD->countPartition(p);
 }
 
 /*
@@ -83,13 +179,15 @@ vector<string> PairRDD<K, V, T>::preferredLocations(Partition *p)
 template <class K, class V, class T>
 IteratorSeq< Pair<K, V> > * PairRDD<K, V, T>::iteratorSeq(Partition *p)
 {
-	IteratorSeq< Pair<K, V> > * ret = prevRDD->iteratorSeq(p)->map(mapToPairFunction);
+	IteratorSeq<T> *prev = prevRDD->getOrCompute(p);
+	IteratorSeq< Pair<K, V> > * ret = prev->map(mapToPairFunction);
 	this->addIteratorSeq(ret); // for garbage collection
 	return ret;
 }
 
 /*
- * to create a new PairRDD modifying the type and(or) value of this PairRDD
+ * to create a new PairRDD modifying the type and(or) value of this PairRDD.
+ * f maps whole pairs and may change keys, so the partitioner is not kept.
  */
 template <class K, class V, class T>
 template <class U>
@@ -99,12 +197,16 @@ PairRDD<K, U, Pair<K, V> > * PairRDD<K, V, T>::mapValues(Pair<K, U> (*f)(Pair<K,
 }
 
 /*
- * do nothing for a Pair.
- * used when change a RDD<Pair> to a PairRDD
+ * to create a new PairRDD mapping only values of this PairRDD.
+ * keys cannot be changed by f, so the partitioner of this PairRDD is kept,
+ * and joins with RDDs partitioned alike need no shuffle.
  */
-template <class K, class V>
-Pair< K, V > xyz_pair_rdd_do_nothing_f(Pair< K, V > &p) {
-	return p;
+template <class K, class V, class T>
+template <class U>
+PairRDD<K, U, Pair<K, U> > * PairRDD<K, V, T>::mapValues(U (*f)(V&))
+{
+	MappedValuesRDD<K, U, V> *mappedRDD = new MappedValuesRDD<K, U, V>(this, f);
+	return mappedRDD->mapToPair(xyz_pair_rdd_do_nothing_f<K, U>);
 }
 
 /*
@@ -125,6 +227,66 @@ MappedRDD<V, Pair< K, V > > * PairRDD<K, V, T>::values() {
 	return this->map(xyz_pair_rdd_values_inner_map_f< K, V >);
 }
 
+/*
+ * return left side of a pair.
+ */
+template <class K, class V>
+K xyz_pair_rdd_count_by_key_inner_key_f (Pair< K, V > &p) {
+	return p.v1;
+}
+
+/*
+ * to count pairs of each key in this PairRDD.
+ * pairs are counted by key in each partition, then counts of partitions are added up.
+ */
+template <class K, class V, class T>
+std::map<K, long> PairRDD<K, V, T>::countByKey() {
+	this->shuffle();
+
+	// construct tasks
+	vector< Task< vector< Pair<K, long> > >* > tasks;
+	vector<Partition*> pars = this->getPartitions();
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		Task< vector< Pair<K, long> > > *task = new CountByKeyTask<Pair<K, V>, K>(
+				this, pars[i], xyz_pair_rdd_count_by_key_inner_key_f<K, V>);
+		tasks.push_back(task);
+	}
+	VectorAutoPointer< Task< vector< Pair<K, long> > > > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult< vector< Pair<K, long> > >* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult< vector< Pair<K, long> > > > auto_ptr2(results); // delete pointers automatically
+
+	std::map<K, long> ret;
+	for(unsigned int i=0; i<results.size(); i++)
+	{
+		vector< Pair<K, long> > &counts = results[i]->value;
+		for(unsigned int j=0; j<counts.size(); j++)
+		{
+			ret[counts[j].v1] += counts[j].v2;
+		}
+	}
+	return ret;
+}
+
+/*
+ * sampling pairs into a new SampledByKeyRDD, with the fraction of each key.
+ * pairs of keys not in fractions are not kept.
+ */
+template <class K, class V, class T>
+SampledByKeyRDD<K, V> * PairRDD<K, V, T>::sampleByKey(bool withReplacement,
+		std::map<K, double> &fractions, long seed) {
+	typename std::map<K, double>::iterator it;
+	for (it = fractions.begin(); it != fractions.end(); ++it) {
+		if (it->second < 0 || (!withReplacement && it->second > 1)) {
+			Logging::logError("PairRDD: sampleByKey fraction should be in [0, 1], or not negative with replacement!");
+			exit(104);
+		}
+	}
+	return new SampledByKeyRDD<K, V>(this, withReplacement, fractions, seed);
+}
+
 /*
  * combine by key hash function.
  * return the hash of left side key of a pair
@@ -154,7 +316,7 @@ Pair<K, C> xyz_pair_rdd_combine_by_key_inner_from_string_f (string &s) {
 }
 
 /*
- * combineByKey is depended by reduceByKey, groupByKey.
+ * combineByKey is depended by reduceByKey.
  * combineByKey will create a ShuffledRDD.
  * a ShuffledRDD can shuffle data set of current RDD to new partitions in the new ShuffledRDD.
  */
@@ -164,6 +326,19 @@ PairRDD<K, C, Pair<K, C> > * PairRDD<K, V, T>::combineByKey(
 		Pair<K, C> (*createCombiner)(Pair<K, V>&),
 		Pair<K, C> (*mergeCombiner)(Pair<K, C>&, Pair<K, C>&),
 		int numPartitions)
+ {
+	return combineByKey(createCombiner, mergeCombiner, numPartitions, false);
+ }
+
+/*
+ * combineByKey, which may coalesce or split partitions of the ShuffledRDD after the map stage
+ */
+template <class K, class V, class T>
+template <class C>
+PairRDD<K, C, Pair<K, C> > * PairRDD<K, V, T>::combineByKey(
+		Pair<K, C> (*createCombiner)(Pair<K, V>&),
+		Pair<K, C> (*mergeCombiner)(Pair<K, C>&, Pair<K, C>&),
+		int numPartitions, bool adaptive)
  {
 	Aggregator< Pair<K, V>, Pair<K, C> > agg(createCombiner, mergeCombiner);
 	HashDivider hd(numPartitions);
@@ -175,6 +350,7 @@ PairRDD<K, C, Pair<K, C> > * PairRDD<K, V, T>::combineByKey(
 					xyz_pair_rdd_combine_by_key_inner_hash_f<K, C>,
 					xyz_pair_rdd_combine_by_key_inner_to_string_f<K, C>,
 					xyz_pair_rdd_combine_by_key_inner_from_string_f<K, C>);
+	shuffledRDD->setAdaptive(adaptive);
 	return shuffledRDD->mapToPair(xyz_pair_rdd_do_nothing_f<K, C>);
  }
 
@@ -191,63 +367,108 @@ PairRDD<K, V, Pair<K, V> > * PairRDD<K, V, T>::reduceByKey(
 
 /*
  * reduceByKey without specifying the partition number in ShuffledRDD.
- * the partition number will be the total threads count.
+ * the partition number is decided by defaultPartitions.
  */
 template <class K, class V, class T>
 PairRDD<K, V, Pair<K, V> > * PairRDD<K, V, T>::reduceByKey(
 		Pair<K, V> (*reduce_function)(Pair<K, V>&, Pair<K, V>&))
 {
+	bool adaptive = false;
+	int numPartitions = this->defaultPartitions(adaptive);
 	return combineByKey(
 			xyz_pair_rdd_do_nothing_f<K, V>,
 			reduce_function,
-			(this->context)->getTotalThreads());
+			numPartitions, adaptive);
 }
 
 /*
- * create combiner for groupByKey.
+ * the partition number of shuffle operators, if not specified.
+ * it is the total threads count,
+ * or more if the partitions can be coalesced by sizes of map output (XYZ_SHUFFLE_ADAPTIVE_MODE).
+ * pushed shuffle sends data to reduce hosts before sizes are known, so partitions are not coalesced.
+ * the mode is off by default, coalesced or split partitions are not hash partitioned any more,
+ * so joins and shuffles by the same key after them cannot reuse the partitioning.
  */
-template <class K, class V>
-Pair<K, VectorIteratorSeq<V> > xyz_pair_rdd_group_by_key_inner_create_combiner ( Pair<K, V> &p) {
-	VectorIteratorSeq<V> iv;
-	iv.push_back(p.v2);
-	return Pair<K, VectorIteratorSeq<V> >(p.v1, iv);
+template <class K, class V, class T>
+int PairRDD<K, V, T>::defaultPartitions(bool &adaptive)
+{
+	int threads = (this->context)->getTotalThreads();
+	adaptive = XYZ_SHUFFLE_ADAPTIVE_MODE == 1 && XYZ_SHUFFLE_PUSH_MODE != 1
+			&& XYZ_SHUFFLE_ADAPTIVE_PARTITION_FACTOR > 1;
+	return adaptive ? threads * XYZ_SHUFFLE_ADAPTIVE_PARTITION_FACTOR : threads;
 }
 
 /*
- * merge function used by groupByKey
+ * groupByKey for data set in this PairRDD
  */
-template <class K, class V>
-Pair<K, VectorIteratorSeq<V> > xyz_pair_rdd_group_by_key_inner_merge_combiner (
-		Pair<K, VectorIteratorSeq<V> > &p1,
-		Pair<K, VectorIteratorSeq<V> > &p2) {
-	vector<V> vv1 = p1.v2.getVector();
-	vector<V> vv2 = p2.v2.getVector();
-	VectorIteratorSeq<V> iv(vv1);
-	iv.push_back(vv2);
-	return Pair<K, VectorIteratorSeq<V> >(p1.v1, iv);
+template <class K, class V, class T>
+PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * PairRDD<K, V, T>::groupByKey(
+		int num_partitions) {
+	return groupByKey(num_partitions, false);
 }
 
 /*
- * groupByKey for data set in this PairRDD
+ * groupByKey, which may coalesce partitions of the GroupedRDD after the map stage.
+ * groups are never split, as each key has exactly one group.
  */
 template <class K, class V, class T>
 PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * PairRDD<K, V, T>::groupByKey(
-		int num_partitions) {
-	return combineByKey(
-			xyz_pair_rdd_group_by_key_inner_create_combiner<K, V>,
-			xyz_pair_rdd_group_by_key_inner_merge_combiner<K, V>,
-			num_partitions);
+		int num_partitions, bool adaptive) {
+	HashDivider hd(num_partitions);
+	GroupedRDD<K, V> *groupedRDD =
+			new GroupedRDD<K, V>(
+					this,
+					hd,
+					xyz_pair_rdd_combine_by_key_inner_hash_f<K, V>,
+					xyz_pair_rdd_combine_by_key_inner_to_string_f<K, V>,
+					xyz_pair_rdd_combine_by_key_inner_from_string_f<K, V>);
+	groupedRDD->setAdaptive(adaptive);
+	return groupedRDD->mapToPair(xyz_pair_rdd_do_nothing_f<K, VectorIteratorSeq<V> >);
+}
 
+/*
+ * groupByKey without specifying partition number of the GroupedRDD.
+ * the partition number is decided by defaultPartitions.
+ */
+template <class K, class V, class T>
+PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * PairRDD<K, V, T>::groupByKey() {
+	bool adaptive = false;
+	int numPartitions = this->defaultPartitions(adaptive);
+	return groupByKey(numPartitions, adaptive);
+
+}
+
+/*
+ * sort data set of this PairRDD by key.
+ * keys are compared by operator< of K, pairs are divided into key ranges chosen by sampling.
+ */
+template <class K, class V, class T>
+PairRDD<K, V, Pair<K, V> > * PairRDD<K, V, T>::sortByKey(bool ascending, int numPartitions) {
+	SortedRDD<K, V> *sortedRDD =
+			new SortedRDD<K, V>(
+					this,
+					numPartitions,
+					ascending,
+					xyz_pair_rdd_combine_by_key_inner_to_string_f<K, V>,
+					xyz_pair_rdd_combine_by_key_inner_from_string_f<K, V>);
+	return sortedRDD->mapToPair(xyz_pair_rdd_do_nothing_f<K, V>);
 }
 
 /*
- * groupByKey without specifying partition number of the ShuffledRDD.
+ * sortByKey without specifying the partition number in SortedRDD.
  * the partition number will be the total threads count.
  */
 template <class K, class V, class T>
-PairRDD<K, VectorIteratorSeq<V>, Pair<K, VectorIteratorSeq<V> > > * PairRDD<K, V, T>::groupByKey() {
-	return groupByKey((this->context)->getTotalThreads());
+PairRDD<K, V, Pair<K, V> > * PairRDD<K, V, T>::sortByKey(bool ascending) {
+	return sortByKey(ascending, (this->context)->getTotalThreads());
+}
 
+/*
+ * sort data set of this PairRDD by key in ascending order
+ */
+template <class K, class V, class T>
+PairRDD<K, V, Pair<K, V> > * PairRDD<K, V, T>::sortByKey() {
+	return sortByKey(true);
 }
 
 /*
@@ -307,19 +528,49 @@ vector< Pair< K, Pair< V, W > > > xyz_pair_rdd_join_inner_flat_map_f(Pair< K, Ve
 
 /*
  * to join RDD< Pair< K, V > > and RDD< Pair< K, W > >
- * return PairRDD< K, Pair< V, W> >
+ * return PairRDD< K, Pair< V, W> >.
+ * if both RDDs are hash partitioned into num_partitions, they are joined without shuffle.
  */
 template <class K, class V, class T>
 template <class W>
 PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * PairRDD<K, V, T>::join(
 		RDD< Pair< K, W > > *other,
 		int num_partitions) {
+	HashDivider *lp = this->getPartitioner();
+	HashDivider *rp = other->getPartitioner();
+	if (lp != NULL && rp != NULL && lp->equals(*rp) && lp->getNumPartitions() == num_partitions) {
+		ZippedJoinRDD<K, V, W> *joinedRDD = new ZippedJoinRDD<K, V, W>(this, other);
+		return joinedRDD->mapToPair(xyz_pair_rdd_do_nothing_f< K, Pair< V, W > >);
+	}
+	return shuffleJoin(other, num_partitions, false);
+}
+
+/*
+ * to join by grouping both RDDs with a GroupedRDD.
+ * skewed or large partitions of the GroupedRDD are split by the larger side, see GroupedRDD::splitPartitions.
+ */
+template <class K, class V, class T>
+template <class W>
+PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * PairRDD<K, V, T>::shuffleJoin(
+		RDD< Pair< K, W > > *other,
+		int num_partitions, bool adaptive) {
 	MappedRDD< Pair<K, Either<V, W> >, Pair<K, V> > *mapRDD1 = this->map(xyz_pair_rdd_join_inner_map_left_f<K, V, W>);
 	MappedRDD< Pair<K, Either<V, W> >, Pair<K, W> > *mapRDD2 = other->map(xyz_pair_rdd_join_inner_map_right_f<K, V, W>);
 
 	UnionRDD< Pair<K, Either<V, W> > > *all = mapRDD1->unionRDD(mapRDD2);
-	return all->mapToPair(xyz_pair_rdd_do_nothing_f< K, Either<V, W> >)
-			->groupByKey(num_partitions)
+
+	// grouped like groupByKey, partitions of this RDD come first in the union
+	HashDivider hd(num_partitions);
+	GroupedRDD< K, Either<V, W> > *groupedRDD =
+			new GroupedRDD< K, Either<V, W> >(
+					all->mapToPair(xyz_pair_rdd_do_nothing_f< K, Either<V, W> >),
+					hd,
+					xyz_pair_rdd_combine_by_key_inner_hash_f< K, Either<V, W> >,
+					xyz_pair_rdd_combine_by_key_inner_to_string_f< K, Either<V, W> >,
+					xyz_pair_rdd_combine_by_key_inner_from_string_f< K, Either<V, W> >);
+	groupedRDD->setAdaptive(adaptive);
+	groupedRDD->setJoinSides(mapRDD1->getPartitions().size());
+	return groupedRDD->mapToPair(xyz_pair_rdd_do_nothing_f<K, VectorIteratorSeq< Either<V, W> > >)
 			->flatMap(xyz_pair_rdd_join_inner_flat_map_f<K, V, W>)
 			->mapToPair(xyz_pair_rdd_do_nothing_f< K, Pair< V, W > >);
 
@@ -327,13 +578,34 @@ PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * PairRDD<K, V, T>::join(
 
 /*
  * to join two RDD without specifying partition number of new ShuffledRDD.
- * the partition number will be the total threads count.
+ * the partition number will be the partition number of both RDDs if they are co-partitioned,
+ * or decided by defaultPartitions.
  */
 template <class K, class V, class T>
 template <class W>
 PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * PairRDD<K, V, T>::join(
 		RDD< Pair< K, W > > *other) {
-	return join(other, (this->context)->getTotalThreads());
+	HashDivider *lp = this->getPartitioner();
+	HashDivider *rp = other->getPartitioner();
+	if (lp != NULL && rp != NULL && lp->equals(*rp)) {
+		return join(other, lp->getNumPartitions());
+	}
+	bool adaptive = false;
+	int numPartitions = this->defaultPartitions(adaptive);
+	return shuffleJoin(other, numPartitions, adaptive);
+}
+
+/*
+ * to join this PairRDD with a small RDD< Pair< K, W > >.
+ * the small RDD is sent to every node once and this PairRDD is not shuffled,
+ * so the small RDD must fit in memory of each node.
+ */
+template <class K, class V, class T>
+template <class W>
+PairRDD< K, Pair< V, W >, Pair< K, Pair< V, W > > > * PairRDD<K, V, T>::broadcastJoin(
+		RDD< Pair< K, W > > *small) {
+	BroadcastJoinRDD<K, V, W> *joinedRDD = new BroadcastJoinRDD<K, V, W>(this, small);
+	return joinedRDD->mapToPair(xyz_pair_rdd_do_nothing_f< K, Pair< V, W > >);
 }
 
 #endif /* PIARRDD_HPP_ */
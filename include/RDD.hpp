@@ -4,22 +4,39 @@
 #include "RDD.h"
 
 #include <iostream>
+#include <algorithm>
+#include <stdio.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <math.h>
 
 #include "ReduceTask.hpp"
+#include "AggregateTask.hpp"
 #include "Task.hpp"
 #include "TaskResult.hpp"
 #include "VectorIteratorSeq.hpp"
 #include "MappedRDD.hpp"
 #include "FlatMappedRDD.hpp"
+#include "MapPartitionsRDD.hpp"
+#include "FilteredRDD.hpp"
+#include "SampledRDD.hpp"
+#include "CoalescedRDD.hpp"
+#include "RoundRobinRDD.hpp"
+#include "GroupedRDD.hpp"
 #include "PairRDD.hpp"
 #include "Partition.hpp"
 #include "SunwayMRContext.hpp"
 #include "Logging.hpp"
 #include "CollectTask.hpp"
+#include "TopTask.hpp"
+#include "CountTask.hpp"
+#include "CountByKeyTask.hpp"
 #include "Pair.hpp"
 #include "UnionRDD.hpp"
+#include "HashDivider.hpp"
 #include "VectorAutoPointer.hpp"
 #include "StringConversion.hpp"
+#include "MemoryGovernor.hpp"
 using namespace std;
 
 /*
@@ -27,10 +44,12 @@ using namespace std;
  */
 template <class T>
 RDD<T>::RDD(SunwayMRContext *c)
-: context(c), sticky(false)
+: context(c), sticky(false), storageLevel(STORAGE_NONE),
+  storageToString(NULL), storageFromString(NULL)
 {
 	rddID = XYZ_CURRENT_RDD_ID++;
 	pthread_mutex_init(&mutex_iterator_seqs, NULL);
+	pthread_mutex_init(&mutex_storage, NULL);
 }
 
 /*
@@ -57,6 +76,10 @@ void RDD<T>::initRDDFrom(const RDD<T> &r) {
 	this->rddID = r.rddID;
 	this->iteratorSeqs = r.iteratorSeqs;
 	this->sticky = r.sticky;
+	this->storageLevel = r.storageLevel;
+	this->storagePath = r.storagePath;
+	this->storageToString = r.storageToString;
+	this->storageFromString = r.storageFromString;
 }
 
 /*
@@ -65,6 +88,7 @@ void RDD<T>::initRDDFrom(const RDD<T> &r) {
 template <class T>
 RDD<T>::~RDD()
 {
+	this->unpersist();
 	this->clean();
 }
 
@@ -86,6 +110,376 @@ void RDD<T>::setSticky(bool s) {
 	sticky = s;
 }
 
+/*
+ * inner function to serialize a persisted partition
+ */
+template <class T>
+string rdd_inner_storage_to_string_f(IteratorSeq<T> &seq) {
+	return to_string(seq);
+}
+
+/*
+ * inner function to deserialize a persisted partition
+ */
+template <class T>
+void rdd_inner_storage_from_string_f(VectorIteratorSeq<T> &seq, string &s) {
+	from_string(seq, s);
+}
+
+/*
+ * to keep computed partitions of this RDD on the nodes computing them,
+ * so later jobs reuse them instead of computing them again.
+ * a persisted RDD is sticky, as its data must outlive the job.
+ * STORAGE_MEMORY_ONLY_SER and STORAGE_DISK_ONLY need to_string and from_string of T.
+ */
+template <class T>
+void RDD<T>::persist(StorageLevel level) {
+	if(level == STORAGE_MEMORY_ONLY_SER || level == STORAGE_DISK_ONLY) {
+		storageToString = rdd_inner_storage_to_string_f<T>;
+		storageFromString = rdd_inner_storage_from_string_f<T>;
+	}
+	this->setStorageLevel(level);
+}
+
+/*
+ * to keep computed partitions of this RDD in memory, as STORAGE_MEMORY_ONLY.
+ */
+template <class T>
+void RDD<T>::cache() {
+	this->setStorageLevel(STORAGE_MEMORY_ONLY);
+}
+
+/*
+ * to set the storage level, dropping partitions stored with another level.
+ */
+template <class T>
+void RDD<T>::setStorageLevel(StorageLevel level) {
+	if(storageLevel == level) {
+		return;
+	}
+	this->unpersist();
+
+	// files of different applications on the same host are kept apart by pid
+	storagePath = XYZ_RDD_STORAGE_DIR + to_string((long)getpid())
+			+ "/rdd_" + to_string(rddID) + "_";
+	storageLevel = level;
+	if(level != STORAGE_NONE) {
+		sticky = true;
+	}
+	if(level == STORAGE_MEMORY_ONLY_SER || level == STORAGE_DISK_ONLY) {
+		XYZ_MEMORY_GOVERNOR.addConsumer(this);
+	}
+}
+
+/*
+ * to drop all stored partitions of this RDD, and stop storing them.
+ */
+template <class T>
+void RDD<T>::unpersist() {
+	if(storageLevel == STORAGE_NONE) {
+		return;
+	}
+
+	if(storageLevel == STORAGE_MEMORY_ONLY_SER || storageLevel == STORAGE_DISK_ONLY) {
+		XYZ_MEMORY_GOVERNOR.removeConsumer(this);
+	}
+
+	pthread_mutex_lock(&mutex_storage);
+	StorageLevel level = storageLevel;
+	storageLevel = STORAGE_NONE;
+	size_t bytes = 0;
+	std::map<Partition *, size_t>::iterator sit;
+	for(sit = storedSeqBytes.begin(); sit != storedSeqBytes.end(); ++sit) {
+		bytes += sit->second;
+	}
+	std::map<Partition *, string>::iterator it;
+	for(it = storedBlocks.begin(); it != storedBlocks.end(); ++it) {
+		bytes += it->second.size();
+	}
+	typename std::map<Partition *, IteratorSeq<T> *>::iterator lit;
+	for(lit = loadedSeqs.begin(); lit != loadedSeqs.end(); ++lit) {
+		bytes += loadedBytes[lit->first];
+		delete lit->second;
+	}
+	storedSeqs.clear();
+	storedSeqBytes.clear();
+	storedBlocks.clear();
+	loadedSeqs.clear();
+	loadedBytes.clear();
+	storedHosts.clear();
+	pthread_mutex_unlock(&mutex_storage);
+	XYZ_MEMORY_GOVERNOR.releaseAcquired(bytes);
+
+	// forked task processes may have written any partition,
+	// so all files of this RDD are removed
+	if(level == STORAGE_DISK_ONLY) {
+		string dir = storagePath.substr(0, storagePath.rfind('/') + 1);
+		string prefix = storagePath.substr(dir.size());
+		DIR *d = opendir(dir.c_str());
+		if(d != NULL) {
+			struct dirent *entry;
+			while((entry = readdir(d)) != NULL) {
+				string name = entry->d_name;
+				if(name.compare(0, prefix.size(), prefix) == 0) {
+					unlink((dir + name).c_str());
+				}
+			}
+			closedir(d);
+		}
+	}
+}
+
+/*
+ * to get the storage level, STORAGE_NONE if not persisted.
+ */
+template <class T>
+StorageLevel RDD<T>::getStorageLevel() {
+	return storageLevel;
+}
+
+/*
+ * called by XYZ_MEMORY_GOVERNOR when memory runs short.
+ * deserialized copies are dropped first, only if idle, as running tasks may be reading them.
+ * then partitions stored serialized in memory are dropped, and computed again when needed.
+ */
+template <class T>
+size_t RDD<T>::spill(size_t bytes, bool idle) {
+	size_t freed = 0;
+	pthread_mutex_lock(&mutex_storage);
+	while(idle && freed < bytes && !loadedSeqs.empty()) {
+		typename std::map<Partition *, IteratorSeq<T> *>::iterator it = loadedSeqs.begin();
+		freed += loadedBytes[it->first];
+		loadedBytes.erase(it->first);
+		delete it->second;
+		loadedSeqs.erase(it);
+	}
+	while(freed < bytes && !storedBlocks.empty()) {
+		freed += storedBlocks.begin()->second.size();
+		storedBlocks.erase(storedBlocks.begin());
+	}
+	pthread_mutex_unlock(&mutex_storage);
+	return freed;
+}
+
+/*
+ * path of the file storing a partition, named by its index in this RDD.
+ * RDD ids and partitions are the same on all nodes and in forked processes.
+ */
+template <class T>
+string RDD<T>::storageFile(Partition *p) {
+	vector<Partition*> pars = this->getPartitions();
+	long index = 0;
+	while(index < (long)pars.size() && pars[index] != p) {
+		index++;
+	}
+	return storagePath + to_string(index);
+}
+
+/*
+ * to get data set of a partition.
+ * a partition of a persisted RDD is computed once on a node, then read from storage.
+ */
+template <class T>
+IteratorSeq<T> * RDD<T>::getOrCompute(Partition *p) {
+	if(storageLevel == STORAGE_NONE) {
+		return this->iteratorSeq(p);
+	}
+
+	IteratorSeq<T> *seq = this->getStored(p);
+	if(seq == NULL) {
+		seq = this->iteratorSeq(p);
+		this->store(p, seq);
+	}
+	return seq;
+}
+
+/*
+ * to count values in a partition.
+ * sub-classes may count without computing the values.
+ */
+template <class T>
+size_t RDD<T>::countPartition(Partition *p) {
+	return this->getOrCompute(p)->size();
+}
+
+/*
+ * to filter data set of a partition, for FilteredRDD.
+ * selectivity is the expected fraction of values passing, negative if unknown.
+ * count is set to the number of values before filtering.
+ * sub-classes may filter values as they are computed, without keeping all of them.
+ */
+template <class T>
+IteratorSeq<T> * RDD<T>::filteredIteratorSeq(Partition *p, bool (*f)(T&),
+		double selectivity, size_t &count) {
+	IteratorSeq<T> *seq = this->getOrCompute(p);
+	count = seq->size();
+	return seq->filter(f, selectivity < 0 ? 0 : (size_t)(count * selectivity));
+}
+
+/*
+ * to get stored data of a partition, NULL if not stored on this node.
+ * a serialized partition is deserialized once, and kept while it fits in the memory budget.
+ */
+template <class T>
+IteratorSeq<T> * RDD<T>::getStored(Partition *p) {
+	string block;
+	bool found = false;
+
+	pthread_mutex_lock(&mutex_storage);
+	std::map<Partition *, IteratorSeq<T> *> &seqs =
+			storageLevel == STORAGE_MEMORY_ONLY ? storedSeqs : loadedSeqs;
+	typename std::map<Partition *, IteratorSeq<T> *>::iterator it = seqs.find(p);
+	if(it != seqs.end() || storageLevel == STORAGE_MEMORY_ONLY) {
+		IteratorSeq<T> *seq = it == seqs.end() ? NULL : it->second;
+		pthread_mutex_unlock(&mutex_storage);
+		return seq;
+	} else if(storageLevel == STORAGE_MEMORY_ONLY_SER) {
+		std::map<Partition *, string>::iterator it = storedBlocks.find(p);
+		if(it != storedBlocks.end()) {
+			block = it->second;
+			found = true;
+		}
+	}
+	pthread_mutex_unlock(&mutex_storage);
+
+	if(storageLevel == STORAGE_DISK_ONLY) {
+		found = readFile(this->storageFile(p), block);
+	}
+	if(!found) {
+		return NULL;
+	}
+
+	// deserialized outside the lock, about as large as the serialized block.
+	// not kept if it does not fit in the memory budget, owned by this RDD like a computed partition then.
+	IteratorSeq<T> *seq = new VectorIteratorSeq<T>();
+	storageFromString(*(VectorIteratorSeq<T> *)seq, block);
+	size_t bytes = block.size();
+	if(!XYZ_MEMORY_GOVERNOR.acquire(bytes)) {
+		this->addIteratorSeq(seq);
+		return seq;
+	}
+
+	// the first one kept if another task did the same meanwhile
+	pthread_mutex_lock(&mutex_storage);
+	it = loadedSeqs.find(p);
+	bool loaded = it != loadedSeqs.end();
+	if(loaded) {
+		delete seq;
+		seq = it->second;
+	} else {
+		loadedSeqs[p] = seq;
+		loadedBytes[p] = bytes;
+	}
+	pthread_mutex_unlock(&mutex_storage);
+	if(loaded) {
+		XYZ_MEMORY_GOVERNOR.releaseAcquired(bytes);
+	}
+	return seq;
+}
+
+/*
+ * to store data of a computed partition on this node.
+ * a file is renamed into place when written, so it is never read half written.
+ */
+template <class T>
+void RDD<T>::store(Partition *p, IteratorSeq<T> *seq) {
+	if(storageLevel == STORAGE_MEMORY_ONLY) {
+		// values are not serialized, so their size is estimated by the input read to compute them,
+		// at least by the size of the values themselves.
+		// not kept if it does not fit in the memory budget, computed again when needed
+		size_t bytes = max(this->inputBytes(p), seq->size() * sizeof(T));
+		if(!XYZ_MEMORY_GOVERNOR.acquire(bytes)) {
+			return;
+		}
+		pthread_mutex_lock(&mutex_storage);
+		bool stored = storedSeqs.find(p) != storedSeqs.end(); // by another task meanwhile
+		if(!stored) {
+			storedSeqs[p] = seq;
+			storedSeqBytes[p] = bytes;
+		}
+		pthread_mutex_unlock(&mutex_storage);
+		if(stored) {
+			XYZ_MEMORY_GOVERNOR.releaseAcquired(bytes);
+		}
+		return;
+	}
+
+	string block = storageToString(*seq);
+	if(storageLevel == STORAGE_MEMORY_ONLY_SER) {
+		// not kept if it does not fit in the memory budget, computed again when needed
+		size_t bytes = block.size();
+		if(!XYZ_MEMORY_GOVERNOR.acquire(bytes)) {
+			return;
+		}
+		pthread_mutex_lock(&mutex_storage);
+		bool stored = storedBlocks.find(p) != storedBlocks.end(); // by another task meanwhile
+		if(!stored) {
+			storedBlocks[p].swap(block);
+		}
+		pthread_mutex_unlock(&mutex_storage);
+		if(stored) {
+			XYZ_MEMORY_GOVERNOR.releaseAcquired(bytes);
+		}
+	} else if(storageLevel == STORAGE_DISK_ONLY) {
+		string path = this->storageFile(p);
+		mkdirRecursive(path.substr(0, path.rfind('/') + 1).c_str());
+		string tmpPath = path + ".tmp";
+		if(!writeRawFile(tmpPath, block.data(), block.size())
+				|| rename(tmpPath.c_str(), path.c_str()) != 0) {
+			Logging::logError("RDD: failed to write persisted partition " + path);
+		}
+	}
+}
+
+/*
+ * to get preferred locations of a partition for tasks.
+ * the host a persisted partition is computed at comes first, as it stores the partition.
+ */
+template <class T>
+vector<string> RDD<T>::getPreferredLocations(Partition *p) {
+	vector<string> locations = this->preferredLocations(p);
+	if(storageLevel == STORAGE_NONE) {
+		return locations;
+	}
+
+	pthread_mutex_lock(&mutex_storage);
+	std::map<Partition *, string>::iterator it = storedHosts.find(p);
+	if(it != storedHosts.end()) {
+		vector<string>::iterator pos = find(locations.begin(), locations.end(), it->second);
+		if(pos != locations.end()) {
+			locations.erase(pos);
+		}
+		locations.insert(locations.begin(), it->second);
+	}
+	pthread_mutex_unlock(&mutex_storage);
+	return locations;
+}
+
+/*
+ * called on all nodes when a task on the partition is scheduled to run at host.
+ * tasks are scheduled the same way on all nodes,
+ * so all nodes know where persisted partitions are stored.
+ */
+template <class T>
+void RDD<T>::partitionScheduled(Partition *p, string host) {
+	if(storageLevel == STORAGE_NONE) {
+		return;
+	}
+
+	pthread_mutex_lock(&mutex_storage);
+	storedHosts[p] = host;
+	pthread_mutex_unlock(&mutex_storage);
+}
+
+/*
+ * to estimate bytes read to compute a partition, for memory of a task on it.
+ * sub-classes knowing their input tell it, or ask their previous RDDs.
+ */
+template <class T>
+size_t RDD<T>::inputBytes(Partition *p) {
+	return 0;
+}
+
 /*
  * add created IteratorSeq pointer.
  * this is for garbage collection.
@@ -105,6 +499,7 @@ void RDD<T>::clean() {
 	this->deletePartitions();
 	this->deleteIteratorSeqs();
 	pthread_mutex_destroy(&mutex_iterator_seqs);
+	pthread_mutex_destroy(&mutex_storage);
 }
 
 /*
@@ -157,6 +552,63 @@ void RDD<T>::shuffle()
 	// do nothing
 }
 
+/*
+ * virtual function to get the partitioner.
+ * by default, data set is not known to be partitioned by key.
+ */
+template <class T>
+HashDivider * RDD<T>::getPartitioner()
+{
+	return NULL;
+}
+
+/*
+ * mapping each partition of this RDD into a new MapPartitionsRDD.
+ * f appends values of the new partition to the vector.
+ */
+template <class T> template <class U>
+MapPartitionsRDD<U, T> * RDD<T>::mapPartitions(void (*f)(IteratorSeq<T>&, vector<U>&))
+{
+	return new MapPartitionsRDD<U, T>(this, f);
+}
+
+/*
+ * mapping each partition of this RDD, with its index, into a new MapPartitionsRDD.
+ * f appends values of the new partition to the vector.
+ */
+template <class T> template <class U>
+MapPartitionsRDD<U, T> * RDD<T>::mapPartitionsWithIndex(void (*f)(int, IteratorSeq<T>&, vector<U>&))
+{
+	return new MapPartitionsRDD<U, T>(this, f);
+}
+
+/*
+ * filtering this RDD's data set into a new FilteredRDD.
+ * only values passing f are kept.
+ */
+template <class T>
+FilteredRDD<T> * RDD<T>::filter(bool (*f)(T&))
+{
+	return new FilteredRDD<T>(this, f);
+}
+
+/*
+ * sampling this RDD's data set into a new SampledRDD.
+ * without replacement, fraction is the probability each value is kept,
+ * with replacement, the expected times each value is kept.
+ * the same seed gives the same sample.
+ */
+template <class T>
+SampledRDD<T> * RDD<T>::sample(bool withReplacement, double fraction, long seed)
+{
+	if (fraction < 0 || (!withReplacement && fraction > 1))
+	{
+		Logging::logError("RDD: sample fraction should be in [0, 1], or not negative with replacement!");
+		exit(104);
+	}
+	return new SampledRDD<T>(this, withReplacement, fraction, seed);
+}
+
 /*
  * mapping this RDD's data set into a new PairRDD
  */
@@ -206,6 +658,202 @@ T RDD<T>::reduce(T (*g)(T&, T&))
 	return it.reduceLeft(g)[0];
 }
 
+/*
+ * to aggregate values of this RDD into a result of another type.
+ * values of each partition are folded into zero by seqOp,
+ * and results of partitions are merged by combOp, not into zero again.
+ * as zero starts every partition, it should be neutral to combOp,
+ * so that the result does not depend on the number of partitions.
+ * zero is returned for an RDD without partitions.
+ */
+template <class T>
+template <class U>
+U RDD<T>::aggregate(U zero, U (*seqOp)(U&, T&), U (*combOp)(U&, U&))
+{
+	this->shuffle();
+
+	// construct tasks
+	vector< Task<U>* > tasks;
+	vector<Partition*> pars = this->getPartitions();
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		Task<U> *task = new AggregateTask<T, U>(this, pars[i], zero, seqOp, combOp);
+		tasks.push_back(task);
+	}
+	VectorAutoPointer< Task<U> > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult<U>* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult<U> > auto_ptr2(results); // delete pointers automatically
+
+	if (results.size() == 0) return zero;
+	U ret = results[0]->value;
+	for(unsigned int i=1; i<results.size(); i++)
+	{
+		ret = combOp(ret, results[i]->value);
+	}
+	return ret;
+}
+
+/*
+ * to aggregate like aggregate, merging results in levels.
+ * results of tasks are sent to every node, so the levels after the first are merged locally.
+ * at the first level, each task aggregates about partitions^(1/depth) partitions
+ * preferring the same host, so fewer partial results go through the network,
+ * while there are still tasks for all threads.
+ */
+template <class T>
+template <class U>
+U RDD<T>::treeAggregate(U zero, U (*seqOp)(U&, T&), U (*combOp)(U&, U&), int depth)
+{
+	this->shuffle();
+
+	vector<Partition*> pars = this->getPartitions();
+	int scale = (int) ceil(pow((double) pars.size(), 1.0 / (depth > 1 ? depth : 1)));
+	if (scale < 2) scale = 2;
+	int groupNum = (pars.size() + scale - 1) / scale;
+	int totalThreads = this->context->getTotalThreads();
+	if (groupNum < totalThreads) groupNum = totalThreads;
+	if (depth < 2 || groupNum >= (int) pars.size())
+	{
+		return this->aggregate(zero, seqOp, combOp);
+	}
+	int groupSize = (pars.size() + groupNum - 1) / groupNum;
+
+	// group partitions by the host they are computed at
+	vector<string> taskHosts = this->context->getTaskHosts(pars.size());
+	vector<string> hosts;
+	std::map<string, vector<Partition*> > hostPartitions;
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		vector<string> locations = this->getPreferredLocations(pars[i]);
+		string host = locations.size() > 0 ? locations[0] : taskHosts[i];
+		if (hostPartitions.find(host) == hostPartitions.end())
+		{
+			hosts.push_back(host);
+		}
+		hostPartitions[host].push_back(pars[i]);
+	}
+
+	// construct tasks, one for each group
+	vector< Task<U>* > tasks;
+	for(unsigned int i=0; i<hosts.size(); i++)
+	{
+		vector<Partition*> &hps = hostPartitions[hosts[i]];
+		for(unsigned int j=0; j<hps.size(); j+=groupSize)
+		{
+			vector<Partition*> group(hps.begin() + j,
+					hps.begin() + (j + groupSize < hps.size() ? j + groupSize : hps.size()));
+			Task<U> *task = new AggregateTask<T, U>(this, group, zero, seqOp, combOp);
+			tasks.push_back(task);
+		}
+	}
+	VectorAutoPointer< Task<U> > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult<U>* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult<U> > auto_ptr2(results); // delete pointers automatically
+
+	// merge results in levels, scale results at a time
+	vector<U> partials;
+	for(unsigned int i=0; i<results.size(); i++)
+	{
+		partials.push_back(results[i]->value);
+	}
+	while (partials.size() > 1)
+	{
+		vector<U> merged;
+		for(unsigned int i=0; i<partials.size(); i+=scale)
+		{
+			U u = partials[i];
+			for(unsigned int j=i+1; j<partials.size() && j<i+scale; j++)
+			{
+				u = combOp(u, partials[j]);
+			}
+			merged.push_back(u);
+		}
+		partials.swap(merged);
+	}
+	return partials.size() > 0 ? partials[0] : zero;
+}
+
+/*
+ * to fold values of this RDD by op, starting from zero in each partition.
+ * zero should be neutral to op, as in aggregate.
+ */
+template <class T>
+T RDD<T>::fold(T zero, T (*op)(T&, T&))
+{
+	return this->aggregate(zero, op, op);
+}
+
+/*
+ * grouping partitions of this RDD into a new CoalescedRDD of numPartitions partitions.
+ * no values are shuffled, so the partitions may be uneven,
+ * and the partition number is not increased.
+ */
+template <class T>
+CoalescedRDD<T> * RDD<T>::coalesce(int numPartitions)
+{
+	return new CoalescedRDD<T>(this, numPartitions);
+}
+
+/*
+ * inner hash function for repartition, the partition a value is shuffled to
+ */
+template <class T>
+long xyz_rdd_repartition_inner_hash_f (Pair< long, T > &p) {
+	return p.v1;
+}
+
+/*
+ * inner to_string function for repartition
+ */
+template <class T>
+string xyz_rdd_repartition_inner_to_string_f (Pair< long, T > &p) {
+	return to_string(p);
+}
+
+/*
+ * inner from_string function for repartition
+ */
+template <class T>
+Pair< long, T > xyz_rdd_repartition_inner_from_string_f (string &s) {
+	Pair< long, T > p;
+	from_string(p, s);
+	return p;
+}
+
+/*
+ * inner flat map function for repartition, values shuffled to a partition.
+ * p is a copy made by flatMap, so its values are swapped out instead of copied.
+ */
+template <class T>
+vector<T> xyz_rdd_repartition_inner_values_f (Pair< long, VectorIteratorSeq<T> > &p) {
+	vector<T> values;
+	p.v2.swap(values);
+	return values;
+}
+
+/*
+ * shuffling values of this RDD into numPartitions partitions of nearly equal sizes.
+ * values of each partition are sent to new partitions in round robin,
+ * and gathered without combining.
+ */
+template <class T>
+RDD<T> * RDD<T>::repartition(int numPartitions)
+{
+	HashDivider hd(numPartitions);
+	GroupedRDD<long, T> *groupedRDD =
+			new GroupedRDD<long, T>(
+					new RoundRobinRDD<T>(this, numPartitions),
+					hd,
+					xyz_rdd_repartition_inner_hash_f<T>,
+					xyz_rdd_repartition_inner_to_string_f<T>,
+					xyz_rdd_repartition_inner_from_string_f<T>);
+	return groupedRDD->flatMap(xyz_rdd_repartition_inner_values_f<T>);
+}
+
 /*
  * inner map to pair function for distinct
  */
@@ -312,6 +960,244 @@ vector<T> RDD<T>::collect()
 	return ret;
 }
 
+/*
+ * to get the first n values in this RDD.
+ * the first job scans one partition, then each job scans more partitions,
+ * by how many values were found per partition, until n values are found.
+ * every node makes the same decisions, as task results are sent to all nodes.
+ */
+template <class T>
+vector<T> RDD<T>::take(long n)
+{
+	vector<T> ret;
+	if(n <= 0) {
+		return ret;
+	}
+	this->shuffle();
+
+	vector<Partition*> pars = this->getPartitions();
+	long scanned = 0;
+	while((long)ret.size() < n && scanned < (long)pars.size()) {
+		// partitions to scan in this job
+		long tries = 1;
+		if(scanned > 0) {
+			long most = scanned * XYZ_TAKE_SCALE_UP_FACTOR;
+			tries = most;
+			if(ret.size() > 0) { // 1.5 times as many as expected to be needed
+				tries = (long)(1.5 * n * scanned / ret.size()) - scanned;
+				if(tries < 1) tries = 1;
+				if(tries > most) tries = most;
+			}
+		}
+		long end = scanned + tries;
+		if(end > (long)pars.size()) end = pars.size();
+
+		// construct tasks, each collecting no more than values still needed
+		vector< Task< vector<T> >* > tasks;
+		for(long i = scanned; i < end; i++)
+		{
+			Task< vector<T> > *task = new CollectTask<T>(this, pars[i], n - ret.size());
+			tasks.push_back(task);
+		}
+		VectorAutoPointer< Task< vector<T> > > auto_ptr1(tasks); // delete pointers automatically
+
+		// run tasks via context
+		vector< TaskResult< vector<T> >* > results = this->context->runTasks(tasks);
+		VectorAutoPointer< TaskResult< vector<T> > > auto_ptr2(results); // delete pointers automatically
+
+		//get results in the order of partitions
+		for(size_t i = 0; i < results.size() && (long)ret.size() < n; i++)
+		{
+			vector<T> &values = results[i]->value;
+			for(size_t j = 0; j < values.size() && (long)ret.size() < n; j++)
+			{
+				ret.push_back(values[j]);
+			}
+		}
+		scanned = end;
+	}
+	return ret;
+}
+
+/*
+ * to get the first value in this RDD.
+ */
+template <class T>
+T RDD<T>::first()
+{
+	vector<T> values = this->take(1);
+	if (values.size() == 0)
+	{
+		Logging::logWarning("RDD: first found no values in an empty RDD!!!");
+		return T();
+	}
+	return values[0];
+}
+
+/*
+ * default comparison of top and takeOrdered
+ */
+template <class T>
+bool xyz_rdd_ordered_inner_less_f (T &a, T &b) {
+	return a < b;
+}
+
+/*
+ * to get the k largest values of this RDD by less, in descending order.
+ */
+template <class T>
+vector<T> RDD<T>::top(long k, bool (*less)(T&, T&))
+{
+	return this->ordered(k, less, true);
+}
+
+/*
+ * to get the k largest values of this RDD by operator<, in descending order.
+ */
+template <class T>
+vector<T> RDD<T>::top(long k)
+{
+	return this->ordered(k, xyz_rdd_ordered_inner_less_f<T>, true);
+}
+
+/*
+ * to get the k smallest values of this RDD by less, in ascending order.
+ */
+template <class T>
+vector<T> RDD<T>::takeOrdered(long k, bool (*less)(T&, T&))
+{
+	return this->ordered(k, less, false);
+}
+
+/*
+ * to get the k smallest values of this RDD by operator<, in ascending order.
+ */
+template <class T>
+vector<T> RDD<T>::takeOrdered(long k)
+{
+	return this->ordered(k, xyz_rdd_ordered_inner_less_f<T>, false);
+}
+
+/*
+ * to get the first k values in order, largest or smallest first.
+ * each task keeps the first k values of its partition in a bounded heap,
+ * so at most k values per partition are sent, and merged at last.
+ */
+template <class T>
+vector<T> RDD<T>::ordered(long k, bool (*less)(T&, T&), bool largest)
+{
+	vector<T> ret;
+	if (k <= 0) return ret;
+
+	this->shuffle();
+
+	// construct tasks
+	vector< Task< vector<T> >* > tasks;
+	vector<Partition*> pars = this->getPartitions();
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		Task< vector<T> > *task = new TopTask<T>(this, pars[i], k, less, largest);
+		tasks.push_back(task);
+	}
+	VectorAutoPointer< Task< vector<T> > > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult< vector<T> >* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult< vector<T> > > auto_ptr2(results); // delete pointers automatically
+
+	for(unsigned int i=0; i<results.size(); i++)
+	{
+		ret.insert(ret.end(), results[i]->value.begin(), results[i]->value.end());
+	}
+
+	xyz_top_task_order_<T> order(less, largest);
+	if (ret.size() > (size_t)k)
+	{
+		partial_sort(ret.begin(), ret.begin() + k, ret.end(), order);
+		ret.resize(k);
+	}
+	else
+	{
+		sort(ret.begin(), ret.end(), order);
+	}
+	return ret;
+}
+
+/*
+ * to count all values in this RDD.
+ * only the number of values in each partition is sent.
+ */
+template <class T>
+long RDD<T>::count()
+{
+	this->shuffle();
+
+	// construct tasks
+	vector< Task<long>* > tasks;
+	vector<Partition*> pars = this->getPartitions();
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		Task<long> *task = new CountTask<T>(this, pars[i]);
+		tasks.push_back(task);
+	}
+	VectorAutoPointer< Task<long> > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult<long>* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult<long> > auto_ptr2(results); // delete pointers automatically
+
+	long ret = 0;
+	for(unsigned int i=0; i<results.size(); i++)
+	{
+		ret += results[i]->value;
+	}
+	return ret;
+}
+
+/*
+ * inner key function for countByValue, the value itself
+ */
+template <class T>
+T xyz_rdd_count_by_value_inner_key_f (T &t) {
+	return t;
+}
+
+/*
+ * to count each distinct value in this RDD.
+ * values are counted in each partition, then counts of partitions are added up.
+ */
+template <class T>
+std::map<T, long> RDD<T>::countByValue()
+{
+	this->shuffle();
+
+	// construct tasks
+	vector< Task< vector< Pair<T, long> > >* > tasks;
+	vector<Partition*> pars = this->getPartitions();
+	for(unsigned int i=0; i<pars.size(); i++)
+	{
+		Task< vector< Pair<T, long> > > *task =
+				new CountByKeyTask<T, T>(this, pars[i], xyz_rdd_count_by_value_inner_key_f<T>);
+		tasks.push_back(task);
+	}
+	VectorAutoPointer< Task< vector< Pair<T, long> > > > auto_ptr1(tasks); // delete pointers automatically
+
+	// run tasks via context
+	vector< TaskResult< vector< Pair<T, long> > >* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult< vector< Pair<T, long> > > > auto_ptr2(results); // delete pointers automatically
+
+	std::map<T, long> ret;
+	for(unsigned int i=0; i<results.size(); i++)
+	{
+		vector< Pair<T, long> > &counts = results[i]->value;
+		for(unsigned int j=0; j<counts.size(); j++)
+		{
+			ret[counts[j].v1] += counts[j].v2;
+		}
+	}
+	return ret;
+}
+
 /*
  * union this RDD with an other RDD.
  * these two RDD must the same template type RDD.
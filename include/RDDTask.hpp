@@ -33,7 +33,21 @@ template <class T, class U> RDDTask<T, U>::~RDDTask () {
  * to get preferred locations of the partition in this task.
  */
 template <class T, class U> vector<string> RDDTask<T, U>::preferredLocations() {
-	return rdd->preferredLocations(partition);
+	return rdd->getPreferredLocations(partition);
+}
+
+/*
+ * to tell the RDD where its partition is computed, as it may be persisted there.
+ */
+template <class T, class U> void RDDTask<T, U>::scheduled(string host) {
+	rdd->partitionScheduled(partition, host);
+}
+
+/*
+ * to expect the working set of this task from the input of its partition.
+ */
+template <class T, class U> size_t RDDTask<T, U>::memoryExpected() {
+	return rdd->inputBytes(partition);
 }
 
 
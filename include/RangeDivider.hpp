@@ -0,0 +1,98 @@
+/*
+ * RangeDivider.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_RANGEDIVIDER_HPP_
+#define INCLUDE_RANGEDIVIDER_HPP_
+
+#include "RangeDivider.h"
+
+#include <algorithm>
+using namespace std;
+
+/*
+ * constructor
+ */
+template <class K>
+RangeDivider<K>::RangeDivider(int partitions, bool ascending)
+: numPartitions(partitions), ascending(ascending)
+{
+}
+
+/*
+ * get the total number of partitions
+ */
+template <class K>
+int RangeDivider<K>::getNumPartitions()
+{
+	return numPartitions;
+}
+
+/*
+ * get the new partition index for a key.
+ * keys are compared natively by operator< of K.
+ */
+template <class K>
+int RangeDivider<K>::getPartition(K &k)
+{
+	int index = lower_bound(bounds.begin(), bounds.end(), k) - bounds.begin();
+	if(!ascending) {
+		index = bounds.size() - index;
+	}
+	return index;
+}
+
+/*
+ * choose numPartitions - 1 bounds evenly from sorted samples.
+ * duplicate bounds are dropped, so heavily repeated keys may leave some partitions empty.
+ */
+template <class K>
+void RangeDivider<K>::setBounds(vector<K> &samples)
+{
+	bounds.clear();
+	if(samples.size() == 0 || numPartitions <= 1) return;
+
+	sort(samples.begin(), samples.end());
+	size_t n = samples.size();
+	for(int i = 1; i < numPartitions; i++) {
+		size_t pos = (size_t)((double)n * i / numPartitions);
+		if(pos >= n) pos = n - 1;
+		K &candidate = samples[pos];
+		if(bounds.size() == 0 || bounds.back() < candidate) {
+			bounds.push_back(candidate);
+		}
+	}
+}
+
+/*
+ * get the range bounds
+ */
+template <class K>
+vector<K> RangeDivider<K>::getBounds()
+{
+	return bounds;
+}
+
+/*
+ * whether partition 0 holds the smallest keys
+ */
+template <class K>
+bool RangeDivider<K>::isAscending()
+{
+	return ascending;
+}
+
+/*
+ * to determine the equality of two RangeDividers
+ */
+template <class K>
+bool RangeDivider<K>::equals(RangeDivider<K> &rd)
+{
+	return numPartitions == rd.getNumPartitions()
+			&& ascending == rd.isAscending()
+			&& bounds == rd.getBounds();
+}
+
+#endif /* INCLUDE_RANGEDIVIDER_HPP_ */
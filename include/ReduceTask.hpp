@@ -26,7 +26,7 @@ template <class T> ReduceTask<T>::ReduceTask(RDD<T> *r, Partition *p, T (*g)(T&,
  * to run the reduce function on the data in the corresponding partition
  */
 template <class T> vector<T> ReduceTask<T>::run() {
-	IteratorSeq<T> *iter = RDDTask< T, vector<T> >::rdd->iteratorSeq(RDDTask< T, vector<T> >::partition);
+	IteratorSeq<T> *iter = RDDTask< T, vector<T> >::rdd->getOrCompute(RDDTask< T, vector<T> >::partition);
 	return iter->reduceLeft(g);
 }
 
@@ -0,0 +1,132 @@
+/*
+ * RoundRobinRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_ROUNDROBINRDD_HPP_
+#define INCLUDE_ROUNDROBINRDD_HPP_
+
+#include "RoundRobinRDD.h"
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+
+/*
+ * constructor, accepting previous RDD and the number of partitions shuffled to
+ */
+template <class T>
+RoundRobinRDD<T>::RoundRobinRDD(RDD<T> *prev, int numPartitions)
+:RDD< Pair<long, T> >::RDD(prev->context), prevRDD(prev), numPartitions(numPartitions)
+{
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class T>
+RoundRobinRDD<T>::~RoundRobinRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * shuffle the previous RDD, this RoundRobinRDD does not need to shuffle
+ */
+template <class T>
+void RoundRobinRDD<T>::shuffle()
+{
+	prevRDD->shuffle();
+}
+
+/*
+ * get partitions of this RDD.
+ * all partitions are from its previous RDD.
+ */
+template <class T>
+vector<Partition*> RoundRobinRDD<T>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get the preferred locations of the partition, the same as in previous RDD
+ */
+template <class T>
+vector<string> RoundRobinRDD<T>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class T>
+void RoundRobinRDD<T>::partitionScheduled(Partition *p, string host)
+{
+	RDD< Pair<long, T> >::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * the number of values in the partition of previous RDD, unless this RDD is persisted.
+ */
+template <class T>
+size_t RoundRobinRDD<T>::countPartition(Partition *p)
+{
+	if(this->getStorageLevel() != STORAGE_NONE) {
+		return RDD< Pair<long, T> >::countPartition(p);
+	}
+	return prevRDD->countPartition(p);
+}
+
+/*
+ * get the data set in the partition, values paired with partitions in round robin.
+ */
+template <class T>
+IteratorSeq< Pair<long, T> > * RoundRobinRDD<T>::iteratorSeq(Partition *p)
+{
+	IteratorSeq<T> *seq = prevRDD->getOrCompute(p);
+	size_t n = seq->size();
+	long target = numPartitions > 0 ? partitionIndex(p) % numPartitions : 0;
+	if(target < 0) {
+		target = 0;
+	}
+
+	vector< Pair<long, T> > output;
+	output.reserve(n);
+	for(size_t i = 0; i < n; i++) {
+		T t = seq->at(i);
+		output.push_back(Pair<long, T>(target, t));
+		if(++target >= numPartitions) {
+			target = 0;
+		}
+	}
+
+	VectorIteratorSeq< Pair<long, T> > *ret = new VectorIteratorSeq< Pair<long, T> >();
+	ret->swap(output);
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+/*
+ * index of the partition in previous RDD, -1 if not found
+ */
+template <class T>
+int RoundRobinRDD<T>::partitionIndex(Partition *p)
+{
+	vector<Partition*> pars = prevRDD->getPartitions();
+	for(size_t i = 0; i < pars.size(); i++) {
+		if(pars[i] == p) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+#endif /* INCLUDE_ROUNDROBINRDD_HPP_ */
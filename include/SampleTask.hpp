@@ -0,0 +1,84 @@
+/*
+ * SampleTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SAMPLETASK_HPP_
+#define INCLUDE_SAMPLETASK_HPP_
+
+#include "SampleTask.h"
+
+#include "IteratorSeq.hpp"
+#include "RDDTask.hpp"
+#include "Pair.hpp"
+#include "Utils.hpp"
+#include "StringConversion.hpp"
+
+/*
+ * constructor
+ */
+template <class K, class V>
+SampleTask<K, V>::SampleTask(RDD< Pair<K, V> > *r, Partition *p, size_t sampleSize)
+:RDDTask< Pair<K, V>, vector<K> >::RDDTask(r, p), sampleSize(sampleSize) {
+
+}
+
+/*
+ * to pick at most sampleSize keys with a fixed stride.
+ * no random access is needed, so the sampling result is the same on every node.
+ */
+template <class K, class V>
+vector<K> SampleTask<K, V>::run() {
+	IteratorSeq< Pair<K, V> > *seq =
+			RDDTask< Pair<K, V>, vector<K> >::rdd->getOrCompute(RDDTask< Pair<K, V>, vector<K> >::partition);
+	vector<K> ret;
+	size_t n = seq->size();
+	if (n == 0 || sampleSize == 0) return ret;
+
+	if (n <= sampleSize) {
+		ret.reserve(n);
+		for (size_t i = 0; i < n; i++) {
+			ret.push_back(seq->at(i).v1);
+		}
+	} else {
+		ret.reserve(sampleSize);
+		for (size_t i = 0; i < sampleSize; i++) {
+			size_t index = (size_t)((double)i * n / sampleSize);
+			ret.push_back(seq->at(index).v1);
+		}
+	}
+	return ret;
+}
+
+/*
+ * to serialize the sampled keys
+ */
+template <class K, class V>
+string SampleTask<K, V>::serialize(vector<K> &t) {
+	string ret = "";
+	for (unsigned int i=0; i<t.size(); i++) {
+		ret += to_string(t[i]);
+		if (i != t.size()-1) ret += SAMPLE_TASK_DELIMITATION;
+	}
+	return ret;
+}
+
+/*
+ * to deserialize sampled keys from string
+ */
+template <class K, class V>
+vector<K> SampleTask<K, V>::deserialize(string &s) {
+	vector<K> elems;
+	vector<string> vs;
+	splitString(s, vs, SAMPLE_TASK_DELIMITATION);
+
+	for(unsigned int i=0; i<vs.size(); i++) {
+		K k;
+		from_string(k, vs[i]);
+		elems.push_back(k);
+	}
+	return elems;
+}
+
+#endif /* INCLUDE_SAMPLETASK_HPP_ */
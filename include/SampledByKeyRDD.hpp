@@ -0,0 +1,37 @@
+/*
+ * SampledByKeyRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SAMPLEDBYKEYRDD_HPP_
+#define INCLUDE_SAMPLEDBYKEYRDD_HPP_
+
+#include "SampledByKeyRDD.h"
+
+#include "SampledRDD.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+
+/*
+ * constructor, accepting previous RDD, the sampling method, fractions of keys and seed
+ */
+template <class K, class V>
+SampledByKeyRDD<K, V>::SampledByKeyRDD(RDD< Pair<K, V> > *prev, bool withReplacement,
+		std::map<K, double> &fractions, long seed)
+:SampledRDD< Pair<K, V> >::SampledRDD(prev, withReplacement, 0, seed), fractions(fractions)
+{
+	this->uniform = false;
+}
+
+/*
+ * expected times the pair is kept, the fraction of its key
+ */
+template <class K, class V>
+double SampledByKeyRDD<K, V>::fractionOf(Pair<K, V> &p)
+{
+	typename std::map<K, double>::iterator it = fractions.find(p.v1);
+	return it == fractions.end() ? 0 : it->second;
+}
+
+#endif /* INCLUDE_SAMPLEDBYKEYRDD_HPP_ */
@@ -0,0 +1,166 @@
+/*
+ * SampledRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SAMPLEDRDD_HPP_
+#define INCLUDE_SAMPLEDRDD_HPP_
+
+#include "SampledRDD.h"
+
+#include <math.h>
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "RDD.hpp"
+#include "HashDivider.hpp"
+#include "XoshiroRandom.hpp"
+
+/*
+ * constructor, accepting previous RDD, the sampling method, fraction and seed
+ */
+template <class T>
+SampledRDD<T>::SampledRDD(RDD<T> *prev, bool withReplacement, double fraction, long seed)
+:RDD<T>::RDD(prev->context), prevRDD(prev), withReplacement(withReplacement),
+ fraction(fraction), seed(seed), uniform(true)
+{
+}
+
+/*
+ * destructor, deleting previous RDD if not sticky
+ */
+template <class T>
+SampledRDD<T>::~SampledRDD()
+{
+	if(!this->prevRDD->isSticky()) {
+		delete this->prevRDD;
+	}
+}
+
+/*
+ * shuffle the previous RDD, this SampledRDD does not need to shuffle
+ */
+template <class T>
+void SampledRDD<T>::shuffle()
+{
+	prevRDD->shuffle();
+}
+
+/*
+ * get partitions of this RDD.
+ * all partitions are from its previous RDD.
+ */
+template <class T>
+vector<Partition*> SampledRDD<T>::getPartitions()
+{
+	return prevRDD->getPartitions();
+}
+
+/*
+ * get the preferred locations of the partition, the same as in previous RDD
+ */
+template <class T>
+vector<string> SampledRDD<T>::preferredLocations(Partition *p)
+{
+	return prevRDD->getPreferredLocations(p);
+}
+
+/*
+ * a task on the partition computes the partition of previous RDDs as well.
+ */
+template <class T>
+void SampledRDD<T>::partitionScheduled(Partition *p, string host)
+{
+	RDD<T>::partitionScheduled(p, host);
+	prevRDD->partitionScheduled(p, host);
+}
+
+/*
+ * sampling keeps keys in their partitions, so the partitioner of previous RDD holds.
+ */
+template <class T>
+HashDivider * SampledRDD<T>::getPartitioner()
+{
+	return prevRDD->getPartitioner();
+}
+
+/*
+ * get the data set in the partition.
+ * for a small uniform fraction without replacement, the number of values skipped
+ * before the next one kept is drawn from a geometric distribution,
+ * so a random number is drawn per value kept, not per value.
+ */
+template <class T>
+IteratorSeq<T> * SampledRDD<T>::iteratorSeq(Partition *p)
+{
+	IteratorSeq<T> *seq = prevRDD->getOrCompute(p);
+	XoshiroRandom random(seed, partitionIndex(p));
+	size_t n = seq->size();
+	vector<T> output;
+
+	if(uniform && fraction > 0) {
+		output.reserve((size_t)(n * fraction * 1.05) + 1);
+	}
+
+	if(withReplacement) {
+		for(size_t i = 0; i < n; i++) {
+			T t = seq->at(i);
+			long times = random.nextPoisson(fractionOf(t));
+			for(long j = 0; j < times; j++) {
+				output.push_back(t);
+			}
+		}
+	} else if(uniform && fraction > 0 && fraction < XYZ_SAMPLE_GAP_FRACTION) {
+		double logFailure = log(1 - fraction);
+		size_t i = 0;
+		while(true) {
+			double gap = floor(log(1 - random.nextDouble()) / logFailure);
+			if(gap >= n - i) {
+				break;
+			}
+			i += (size_t) gap;
+			output.push_back(seq->at(i));
+			i++;
+		}
+	} else {
+		for(size_t i = 0; i < n; i++) {
+			T t = seq->at(i);
+			if(random.nextDouble() < fractionOf(t)) {
+				output.push_back(t);
+			}
+		}
+	}
+
+	VectorIteratorSeq<T> *ret = new VectorIteratorSeq<T>();
+	ret->swap(output);
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+/*
+ * expected times the value is kept, the same for all values
+ */
+template <class T>
+double SampledRDD<T>::fractionOf(T &t)
+{
+	return fraction;
+}
+
+/*
+ * index of the partition in previous RDD, -1 if not found
+ */
+template <class T>
+int SampledRDD<T>::partitionIndex(Partition *p)
+{
+	vector<Partition*> pars = prevRDD->getPartitions();
+	for(size_t i = 0; i < pars.size(); i++) {
+		if(pars[i] == p) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+#endif /* INCLUDE_SAMPLEDRDD_HPP_ */
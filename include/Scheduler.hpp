@@ -19,5 +19,45 @@ Scheduler::~Scheduler() {
 
 }
 
+pthread_key_t xyz_scheduler_current_key;
+pthread_once_t xyz_scheduler_current_once = PTHREAD_ONCE_INIT;
+
+/*
+ * to create the key of the current scheduler of each thread, once
+ */
+void xyz_scheduler_create_key_() {
+	pthread_key_create(&xyz_scheduler_current_key, NULL);
+}
+
+/*
+ * to reserve idle threads of this node for helper threads of a running task.
+ * by default, no thread is idle.
+ */
+int Scheduler::reserveHelperThreads(int most) {
+	return 0;
+}
+
+/*
+ * helper threads reserved by reserveHelperThreads have finished
+ */
+void Scheduler::releaseHelperThreads(int num) {
+}
+
+/*
+ * to get the scheduler of the task running in this thread, NULL if not a task thread
+ */
+Scheduler * Scheduler::current() {
+	pthread_once(&xyz_scheduler_current_once, xyz_scheduler_create_key_);
+	return (Scheduler *)pthread_getspecific(xyz_scheduler_current_key);
+}
+
+/*
+ * to set the scheduler of the task running in this thread
+ */
+void Scheduler::setCurrent(Scheduler *scheduler) {
+	pthread_once(&xyz_scheduler_current_once, xyz_scheduler_create_key_);
+	pthread_setspecific(xyz_scheduler_current_key, scheduler);
+}
+
 #endif /* SCHEDULER_HPP_ */
 
@@ -17,9 +17,42 @@
  * constructor
  */
 ShuffledPartition::ShuffledPartition(long _rddID, int _partitionID)
-: rddID(_rddID), partitionID(_partitionID)
+: rddID(_rddID), partitionID(_partitionID),
+  firstPartition(_partitionID), lastPartition(_partitionID + 1)
 {
 }
 
+/*
+ * a partition made of several coalesced hash partitions
+ */
+ShuffledPartition::ShuffledPartition(long _rddID, int _partitionID,
+		int _firstPartition, int _lastPartition)
+: rddID(_rddID), partitionID(_partitionID),
+  firstPartition(_firstPartition), lastPartition(_lastPartition)
+{
+}
+
+/*
+ * a slice of a hash partition, made of output of map tasks in some ranges
+ */
+ShuffledPartition::ShuffledPartition(long _rddID, int _partitionID, int _hashPartition,
+		vector< pair<int, int> > &_taskRanges)
+: rddID(_rddID), partitionID(_partitionID),
+  firstPartition(_hashPartition), lastPartition(_hashPartition + 1), taskRanges(_taskRanges)
+{
+}
+
+/*
+ * whether output of a map task belongs to this partition
+ */
+bool ShuffledPartition::hasTask(int task)
+{
+	if(taskRanges.size() == 0) return true;
+	for(size_t i = 0; i < taskRanges.size(); i++) {
+		if(task >= taskRanges[i].first && task < taskRanges[i].second) return true;
+	}
+	return false;
+}
+
 
 #endif /* INCLUDE_SHUFFLEDPARTITION_HPP_ */
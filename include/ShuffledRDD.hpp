@@ -19,10 +19,17 @@
 #include "VectorIteratorSeq.hpp"
 #include "Partition.hpp"
 #include "ShuffledPartition.hpp"
+#include "BaseShuffledRDD.hpp"
 #include "RDD.hpp"
 #include "Pair.hpp"
 #include "SunwayMRContext.hpp"
 #include "ShuffledTask.hpp"
+#include "CombiningTask.hpp"
+#include "ShuffledSliceTask.hpp"
+#include "MapStatus.hpp"
+#include "FlatCombinerMap.hpp"
+#include "NodeCombiner.hpp"
+#include "MessageDecoder.hpp"
 #include "Aggregator.hpp"
 #include "HashDivider.hpp"
 #include "TaskResult.hpp"
@@ -31,6 +38,7 @@
 #include "MessageType.hpp"
 #include "Utils.hpp"
 #include "TaskScheduler.hpp"
+#include "Scheduler.hpp"
 #include "VectorAutoPointer.hpp"
 
 using namespace std;
@@ -45,207 +53,511 @@ ShuffledRDD<K, V, C>::ShuffledRDD(RDD< Pair<K, V> > *_prevRDD,
 		long (*hf)(Pair<K, C> &p),
 		string (*strf)(Pair<K, C> &p),
 		Pair<K, C> (*_recoverFunc)(string &s))
-: RDD< Pair<K, C> >::RDD(_prevRDD->context), prevRDD(_prevRDD), agg(_agg), hd(_hd)
+: BaseShuffledRDD< K, V, Pair<K, C>, Pair<K, C> >::BaseShuffledRDD(_prevRDD, _hd, "ShuffledRDD"), agg(_agg)
 {
 	hashFunc = hf;
 	strFunc = strf;
-	shuffleID = this->rddID;
-	shuffleFinished = false;
 	recoverFunc = _recoverFunc;
-
-	// generate new partitions and initialize mutex
-	vector<Partition*> parts;
-	for(int i = 0; i < hd.getNumPartitions(); i++)
-	{
-		Partition *part = new ShuffledPartition(this->rddID, i);
-		parts.push_back(part);
-
-		this->shuffleMutexes.push_back(pthread_mutex_t());
-		pthread_mutex_init(&this->shuffleMutexes.back(), NULL);
-	}
-	this->partitions = parts;
+	mapSideCombine = XYZ_SHUFFLE_MAP_SIDE_COMBINE == 1;
+	nodeCombiner = NULL;
 
 	// construct shuffle tasks
-	vector<Partition*> pars = prevRDD->getPartitions(); //partitions before shuffle
+	vector<Partition*> pars = this->prevRDD->getPartitions(); //partitions before shuffle
 	for (unsigned int i = 0; i < pars.size(); i++)
 	{
 		//ShuffleTask(RDD<T> &r, Partition &p, long shID, int nPs, HashDivider &hashDivider, Aggregator<T, U> &aggregator, long (*hFunc)(U), string (*sf)(U));
-		ShuffledTask< Pair<K, V>, Pair<K, C> > *task =
-				new ShuffledTask< Pair<K, V>, Pair<K, C> >(
-						prevRDD, pars[i], this->shuffleID, hd.getNumPartitions(),
-						hd, agg, hashFunc, strFunc);
-		shuffledTasks.push_back(task);
+		ShuffledTask< Pair<K, V>, Pair<K, C> > *task;
+		if(mapSideCombine) {
+			task = new CombiningTask<K, V, C>(
+					this->prevRDD, pars[i], this->shuffleID, this->hd.getNumPartitions(),
+					this->hd, agg, hashFunc, strFunc);
+		} else {
+			task = new ShuffledTask< Pair<K, V>, Pair<K, C> >(
+					this->prevRDD, pars[i], this->shuffleID, this->hd.getNumPartitions(),
+					this->hd, agg, hashFunc, strFunc);
+		}
+		this->shuffledTasks.push_back(task);
 	}
 }
 
 /*
  * destructor.
- * deleting all the shuffle tasks and iteratorSeq cache.
- * deleting the previous RDD if that is not sticky.
+ * deleting the node combiner and pushed data,
+ * shuffle tasks and iteratorSeq cache are deleted by BaseShuffledRDD.
  */
 template <class K, class V, class C>
 ShuffledRDD<K, V, C>::~ShuffledRDD()
 {
-	for(size_t i = 0; i < this->shuffledTasks.size(); i++) {
-		delete this->shuffledTasks[i];
+	this->context->releaseShuffleCache(this->shuffleID); // stop serving before deleting the node combiner
+	if(this->nodeCombiner != NULL) {
+		delete this->nodeCombiner;
+		this->nodeCombiner = NULL;
 	}
-	this->shuffledTasks.clear();
 
-	typename map<int, IteratorSeq< Pair<K, C> >* >::iterator it2;
-	for (it2=this->shuffleCache.begin(); it2!=this->shuffleCache.end(); ++it2) {
-		delete (it2->second);
-	}
-	this->shuffleCache.clear();
-
-	if(this->prevRDD != NULL) {
-		delete this->prevRDD;
+	if(XYZ_SHUFFLE_PUSH_MODE == 1) {
+		this->context->clearPushedShuffleData(this->shuffleID);
 	}
 }
 
 /*
- * to get partitions of this RDD.
- * as to ShuffledRDD, the partitions stored in itself, no its previous RDD.
+ * to get the preferred locations of a partition.
+ * a partition prefers the hosts its data was pushed to,
+ * or the hosts holding the largest shares of its map output, by map statuses.
+ * split partitions have no preference, their slices are merged on any host.
  */
 template <class K, class V, class C>
-vector<Partition*> ShuffledRDD<K, V, C>::getPartitions()
+vector<string> ShuffledRDD<K, V, C>::preferredLocations(Partition *p)
 {
-	return this->partitions;
+	vector<string> ve;
+	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
+	if(srp == NULL || !this->shuffleFinished) return ve;
+
+	if(XYZ_SHUFFLE_PUSH_MODE == 1) {
+		if(srp->partitionID < (int)reduceHosts.size()) {
+			ve.push_back(reduceHosts[srp->partitionID]);
+		}
+		return ve;
+	}
+	for(int i = srp->firstPartition; i < srp->lastPartition; i++) {
+		if(slicedPartitions.find(i) != slicedPartitions.end()) return ve;
+	}
+	return MapStatus::preferredHosts(this->mapStatuses, srp->firstPartition, srp->lastPartition, srp->taskRanges);
 }
 
 /*
- * to get the preferred locations of a partition
+ * to set up map tasks before they run.
+ * in push mode, every partition is pushed to the host its reduce task will run at.
  */
 template <class K, class V, class C>
-vector<string> ShuffledRDD<K, V, C>::preferredLocations(Partition *p)
+void ShuffledRDD<K, V, C>::beforeMapStage(bool toFile)
 {
-	vector<string> ve;
-	return ve;
+	if(XYZ_SHUFFLE_PUSH_MODE == 1) {
+		reduceHosts = this->context->getTaskHosts(this->hd.getNumPartitions());
+	}
+	// map tasks on this node combine into one output, only if they run by threads and keep output in memory
+	if(XYZ_SHUFFLE_NODE_COMBINE == 1 && mapSideCombine
+			&& XYZ_SHUFFLE_PUSH_MODE == 0 && !toFile) {
+		nodeCombiner = new NodeCombiner<K, V, C>(this->hd.getNumPartitions(), agg, strFunc);
+	}
+	for(unsigned int i = 0; i < this->shuffledTasks.size(); i++) {
+		if(XYZ_SHUFFLE_PUSH_MODE == 1) {
+			this->shuffledTasks[i]->setPushTargets(this, reduceHosts, this->context->getListenPort());
+		}
+		if(nodeCombiner != NULL) {
+			// map tasks are CombiningTasks, as nodeCombiner requires mapSideCombine
+			static_cast< CombiningTask<K, V, C>* >(this->shuffledTasks[i])->setNodeCombiner(nodeCombiner);
+		}
+	}
+	if(nodeCombiner != NULL) {
+		// served after output of map tasks, which is empty
+		this->context->saveShuffleCache(this->shuffleID, nodeCombiner);
+	}
 }
 
 /*
- * shuffle the data set of previous RDD.
- * to create and run ShuffledTasks on previous RDD's partitions.
+ * to split skewed or large partitions, then coalesce small partitions if adaptive.
  */
 template <class K, class V, class C>
-void ShuffledRDD<K, V, C>::shuffle()
+void ShuffledRDD<K, V, C>::afterMapStage()
 {
-	XYZ_TASK_SCHEDULER_RUN_TASK_MODE = 1;
-
-	if (shuffleFinished) return; // shuffle was done before
-
-	prevRDD->shuffle(); // firstly, the previous RDD must do the shuffle
-
-	// run tasks via context
-	vector< Task<int> *> tasks;
-	for(unsigned int i = 0; i < shuffledTasks.size(); i++) {
-		tasks.push_back(shuffledTasks[i]);
-	}
-	vector< TaskResult<int>* > results = this->context->runTasks(tasks);
-	VectorAutoPointer< TaskResult<int> > auto_ptr2(results); // delete pointers automatically
-
-    // cache tasks
-	for(unsigned int i = 0; i < shuffledTasks.size(); i++) {
-		this->context->saveShuffleCache(this->shuffleID, shuffledTasks[i]);
+	// sizes are measured after map-side combine, only partitions still large are split.
+	// output combined on nodes cannot be sliced by ranges of map tasks.
+	if(nodeCombiner == NULL) {
+		this->splitPartitions();
 	}
+	BaseShuffledRDD< K, V, Pair<K, C>, Pair<K, C> >::afterMapStage();
+}
 
-	this->shuffleFinished = true;
-
-	// !!! as long as shuffle is done, the previous RDD can be destroyed
-	if(!this->prevRDD->isSticky()) {
-		delete this->prevRDD;
-		this->prevRDD = NULL;
-	}
+/*
+ * pairs are partitioned by hash of keys,
+ * unless partitions have been coalesced.
+ */
+template <class K, class V, class C>
+HashDivider * ShuffledRDD<K, V, C>::getPartitioner()
+{
+	if(this->hashPartitions.size() > 0) return NULL;
+	return &this->hd;
 }
 
 /*
  * to get data set of a partition.
  * this is done by several steps:
- *   1) to fetch combiners from other nodes
+ *   1) to take pushed combiners, or fetch combiners from other nodes
  *   2) to merge the combiners with the same key by Aggregator::mergeCombiner
  *   3) to same cache and return IteratorSeq of pairs after combination
  *
- * note: cannot save shuffle cache data in memory if using fork !
+ * note: if using fork, the cache is kept by the forked process only.
  */
 template <class K, class V, class C>
 IteratorSeq< Pair<K, C> > * ShuffledRDD<K, V, C>::iteratorSeq(Partition *p)
 {
 	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
 
-	pthread_mutex_lock(&this->shuffleMutexes[srp->partitionID]);
 	// checking cache
-	if (shuffleCache.find(srp->partitionID) != shuffleCache.end()) {
-		pthread_mutex_unlock(&this->shuffleMutexes[srp->partitionID]);
-		return this->shuffleCache[srp->partitionID];
-	}
-
-	unordered_map<K, C> combiners;
-	typename unordered_map<K, C>::iterator iter;
-
-	// merge local data
-	for(size_t i = 0; i < this->shuffledTasks.size(); i++) {
-		ShuffledTask< Pair<K, V>, Pair<K, C> > * task =
-				this->shuffledTasks[i];
-		IteratorSeq< Pair <K, C > > *data =
-				task->getPartitionData(srp->partitionID);
-		if(data != NULL) {
-			size_t n = data->size();
-			for(size_t j = 0; j < n; j++) {
-				Pair<K, C> p = data->at(j);
-
-				iter = combiners.find(p.v1);
-				if(iter != combiners.end())
-				{
-					// the key exists
-					Pair<K, C> origin(p.v1, combiners[p.v1]);
-					Pair<K, C> newPair = agg.mergeCombiners(origin, p);
-					combiners[p.v1] = newPair.v2;
+	IteratorSeq< Pair<K, C> > *cached = this->lockPartition(srp);
+	if (cached != NULL) {
+		return cached;
+	}
+
+	FlatCombinerMap<K, C> combiners;
+	for(int i = srp->firstPartition; i < srp->lastPartition; i++) {
+		this->combinePartition(i, combiners);
+	}
+
+	// making result, combined pairs are swapped into place instead of copied
+	vector< Pair<K, C> > ret;
+	combiners.swap(ret);
+	VectorIteratorSeq< Pair<K, C> > *retIt = new VectorIteratorSeq< Pair<K, C> >();
+	retIt->swap(ret);
+
+	// saving cache
+	this->unlockPartition(srp, retIt);
+
+	return retIt;
+}
+
+/*
+ * to combine a hash partition.
+ * a split partition only merges combiners of its slices.
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::combinePartition(int partitionID, FlatCombinerMap<K, C> &combiners)
+{
+	// slicedPartitions is not modified after shuffle, other partitions are read concurrently
+	map<int, vector<string> >::iterator sliced = slicedPartitions.find(partitionID);
+	if(sliced != slicedPartitions.end()) {
+		// its slices were combined by ShuffledSliceTasks
+		merge(sliced->second, combiners);
+	}
+	else {
+		this->combine(partitionID, 0, this->shuffledTasks.size(), combiners);
+	}
+}
+
+/*
+ * to combine data of a partition written by map tasks in [firstTask, lastTask).
+ * local output is merged directly, other output is taken from pushed data or fetched.
+ * a large partition is merged by several threads if there are idle threads,
+ * each of which merges pieces of the output into its own combiners,
+ * remote output is fetched by ranges of map tasks then.
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::combine(int partitionID, int firstTask, int lastTask,
+		FlatCombinerMap<K, C> &combiners)
+{
+	bool all = firstTask == 0 && lastTask == (int)this->shuffledTasks.size();
+	int threads = this->mergeThreads(partitionID, firstTask, lastTask);
+	vector<xyz_shuffled_rdd_merge_unit_> units;
+
+	// local data
+	for(int i = firstTask; i < lastTask; i++) {
+		if(this->shuffledTasks[i]->hasOutput()) {
+			units.push_back(xyz_shuffled_rdd_merge_unit_(MERGE_LOCAL_TASK, i));
+		}
+	}
+	if(nodeCombiner != NULL && all) {
+		units.push_back(xyz_shuffled_rdd_merge_unit_(MERGE_NODE));
+	}
+
+	// take pushed data, output of map tasks on other hosts which did not push is fetched alone
+	bool pushed = false;
+	if(XYZ_SHUFFLE_PUSH_MODE == 1 && all) {
+		map<long, string> blocks;
+		this->context->takePushedShuffleData(this->shuffleID, partitionID, blocks);
+		pushed = blocks.size() > 0;
+		string self = getLocalHost();
+		for(int i = 0; pushed && i < (int)this->shuffledTasks.size(); i++) {
+			if(this->shuffledTasks[i]->hasOutput()) continue;
+			map<long, string>::iterator it = blocks.find(this->shuffledTasks[i]->taskID);
+			if(it != blocks.end()) {
+				units.push_back(xyz_shuffled_rdd_merge_unit_(MERGE_BLOCK));
+				units.back().block.swap(it->second);
+				continue;
+			}
+			if(i >= (int)this->mapStatuses.size() || this->mapStatuses[i].host == self) continue;
+			// consecutive missing map tasks of a host are fetched by one request
+			if(!units.empty() && units.back().type == MERGE_FETCH
+					&& units.back().host == this->mapStatuses[i].host && units.back().lastTask == i) {
+				units.back().lastTask = i + 1;
+			} else {
+				units.push_back(xyz_shuffled_rdd_merge_unit_(MERGE_FETCH));
+				units.back().host = this->mapStatuses[i].host;
+				units.back().firstTask = i;
+				units.back().lastTask = i + 1;
+			}
+		}
+	}
+
+	// fetch
+	if(!pushed) {
+		string self = getLocalHost();
+		vector<string> IPs;
+		if(all) {
+			IPs = (this->context)->getHosts();
+		}
+		else {
+			// only hosts where the map tasks ran
+			for(int i = firstTask; i < lastTask && i < (int)this->mapStatuses.size(); i++) {
+				if(find(IPs.begin(), IPs.end(), this->mapStatuses[i].host) == IPs.end()) {
+					IPs.push_back(this->mapStatuses[i].host);
+				}
+			}
+		}
+
+		// ranges of map tasks, output combined on nodes cannot be fetched by ranges
+		int ranges = nodeCombiner == NULL && threads > 1 ? threads : 1;
+		for(size_t h = 0; h < IPs.size(); h++) {
+			if(IPs[h] == self) continue;
+			for(int r = 0; r < ranges; r++) {
+				xyz_shuffled_rdd_merge_unit_ unit(MERGE_FETCH);
+				unit.host = IPs[h];
+				if(ranges > 1 || !all) {
+					unit.firstTask = firstTask + (long)(lastTask - firstTask) * r / ranges;
+					unit.lastTask = firstTask + (long)(lastTask - firstTask) * (r + 1) / ranges;
 				}
-				else
-				{
-					combiners[p.v1] = p.v2;
+				if(ranges > 1) {
+					// skip ranges with no map task on the host
+					bool ran = false;
+					for(int i = unit.firstTask; i < unit.lastTask && i < (int)this->mapStatuses.size(); i++) {
+						if(this->mapStatuses[i].host == IPs[h]) ran = true;
+					}
+					if(!ran) continue;
 				}
+				units.push_back(unit);
 			}
 		}
 	}
 
-	// fetch
-	vector<string> replys;
-	vector<string> IPs = (this->context)->getHosts();
-	int port = (this->context)->getListenPort();
-
-	string self = getLocalHost();
-	string str_shuffleID = num2string(shuffleID);
-	string str_partitionID = num2string(srp->partitionID);
-	string sendMsg = str_shuffleID + "," + str_partitionID; //organize request
-	for(unsigned int i=0; i<IPs.size(); i++)
-	{
-		if(IPs[i] == self) continue;
-		replys.push_back("");
-		sendMessageForReply(IPs[i], port, FETCH_REQUEST, sendMsg, replys.back());
+	// merge, the calling thread merges into the combiners directly
+	size_t next = 0;
+	if(threads > (int)units.size() && threads > 1) {
+		int unused = threads - (units.size() > 0 ? units.size() : 1);
+		this->releaseMergeThreads(unused);
+		threads -= unused;
+	}
+	if(threads <= 1) {
+		this->mergeUnits(partitionID, units, next, NULL, combiners);
+		return;
+	}
+
+	pthread_mutex_t mutex;
+	pthread_mutex_init(&mutex, NULL);
+	vector< xyz_shuffled_rdd_merge_thread_data_<K, V, C>* > helpers;
+	vector<pthread_t> workers;
+	for(int i = 1; i < threads; i++) {
+		xyz_shuffled_rdd_merge_thread_data_<K, V, C> *data =
+				new xyz_shuffled_rdd_merge_thread_data_<K, V, C>(this, partitionID, &units, &next, &mutex);
+		pthread_t worker;
+		if(pthread_create(&worker, NULL, xyz_shuffled_rdd_merge_thread_f<K, V, C>, (void *)data) != 0) {
+			Logging::logWarning("ShuffledRDD: failed to create a thread to merge");
+			delete data;
+			break;
+		}
+		helpers.push_back(data);
+		workers.push_back(worker);
+	}
+	this->releaseMergeThreads(threads - 1 - workers.size()); // threads failed to create
+	this->mergeUnits(partitionID, units, next, &mutex, combiners);
+
+	// merge combiners of helper threads
+	for(size_t i = 0; i < workers.size(); i++) {
+		pthread_join(workers[i], NULL);
+		vector< Pair<K, C> > pairs;
+		helpers[i]->combiners.swap(pairs);
+		delete helpers[i];
+		for(size_t j = 0; j < pairs.size(); j++) {
+			combiners.merge(pairs[j], agg);
+		}
 	}
+	this->releaseMergeThreads(workers.size());
+	pthread_mutex_destroy(&mutex);
 
-	// merge fetched data
-	merge(replys, combiners);
-	replys.clear();
+	stringstream ss;
+	ss << "ShuffledRDD: partition [" << partitionID << "] of shuffle [" << this->shuffleID
+			<< "] merged by [" << workers.size() + 1 << "] threads";
+	Logging::logDebug(ss.str());
+}
 
-	// making result 
-	vector< Pair<K, C> > ret;
-	VectorIteratorSeq< Pair<K, C> > *retIt = new VectorIteratorSeq< Pair<K, C> >(ret);
-	typename unordered_map<K, C>::iterator it;
-	for(it=combiners.begin(); it!=combiners.end(); it++)
+/*
+ * number of threads to combine a partition.
+ * helper threads are used only for a large partition,
+ * and only as many as the idle threads of the task scheduler running this task,
+ * which counts them as running until releaseMergeThreads.
+ */
+template <class K, class V, class C>
+int ShuffledRDD<K, V, C>::mergeThreads(int partitionID, int firstTask, int lastTask)
+{
+	if(XYZ_SHUFFLE_MERGE_THREADS <= 1) return 1;
+
+	long records = 0;
+	for(int i = firstTask; i < lastTask && i < (int)this->mapStatuses.size(); i++) {
+		if(partitionID < (int)this->mapStatuses[i].records.size()) {
+			records += this->mapStatuses[i].records[partitionID];
+		}
+	}
+	if(records < XYZ_SHUFFLE_MERGE_MIN_RECORDS) return 1;
+
+	Scheduler *scheduler = Scheduler::current();
+	if(scheduler == NULL) return 1; // not run by a task
+	return 1 + scheduler->reserveHelperThreads(XYZ_SHUFFLE_MERGE_THREADS - 1);
+}
+
+/*
+ * to give helper threads reserved by mergeThreads back to the task scheduler
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::releaseMergeThreads(int helpers)
+{
+	Scheduler *scheduler = Scheduler::current();
+	if(scheduler != NULL && helpers > 0) {
+		scheduler->releaseHelperThreads(helpers);
+	}
+}
+
+/*
+ * to merge units one by one, until every unit is taken.
+ * mutex is NULL if no other thread is merging.
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::mergeUnits(int partitionID, vector<xyz_shuffled_rdd_merge_unit_> &units,
+		size_t &next, pthread_mutex_t *mutex, FlatCombinerMap<K, C> &combiners)
+{
+	while(true) {
+		if(mutex != NULL) pthread_mutex_lock(mutex);
+		size_t i = next++;
+		if(mutex != NULL) pthread_mutex_unlock(mutex);
+		if(i >= units.size()) break;
+
+		this->mergeUnit(partitionID, units[i], combiners);
+	}
+}
+
+/*
+ * to merge a piece of map output into combiners
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::mergeUnit(int partitionID, xyz_shuffled_rdd_merge_unit_ &unit,
+		FlatCombinerMap<K, C> &combiners)
+{
+	switch(unit.type) {
+	case MERGE_LOCAL_TASK: {
+		// serialized output, decoded in place like fetched data
+		ShuffleDataDecoder<K, V, C> decoder(this, combiners);
+		this->shuffledTasks[unit.task]->decodeData(partitionID, decoder);
+		if (decoder.getInvalid() > 0) {
+			stringstream ss;
+			ss << decoder.getInvalid() << " invalid pairs found in ShuffledRDD::mergeUnit()";
+			Logging::logWarning(ss.str());
+		}
+		break;
+	}
+	case MERGE_NODE: {
+		vector< Pair<K, C> > &data = nodeCombiner->getPartitionData(partitionID);
+		for(size_t j = 0; j < data.size(); j++) {
+			Pair<K, C> p = data[j];
+			combiners.merge(p, agg);
+		}
+		break;
+	}
+	case MERGE_BLOCK: {
+		vector<string> blocks(1);
+		blocks[0].swap(unit.block);
+		merge(blocks, combiners);
+		break;
+	}
+	case MERGE_FETCH: {
+		// merging while received
+		vector<string> IPs(1, unit.host);
+		ShuffleDataDecoder<K, V, C> decoder(this, combiners);
+		this->fetchShuffleData(IPs, (this->context)->getListenPort(), this->shuffleID, partitionID,
+				unit.firstTask, unit.lastTask, decoder);
+		if (decoder.getInvalid() > 0) {
+			stringstream ss;
+			ss << decoder.getInvalid() << " invalid pairs found in ShuffledRDD::mergeUnit()";
+			Logging::logWarning(ss.str());
+		}
+		break;
+	}
+	}
+}
+
+/*
+ * to combine a slice of a split partition, called by ShuffledSliceTask.
+ * return the partial combiners serialized.
+ */
+template <class K, class V, class C>
+string ShuffledRDD<K, V, C>::combineSlice(int partitionID, int firstTask, int lastTask)
+{
+	FlatCombinerMap<K, C> combiners;
+	this->combine(partitionID, firstTask, lastTask, combiners);
+	vector< Pair<K, C> > pairs;
+	combiners.swap(pairs);
+
+	string ret;
+	for(size_t i = 0; i < pairs.size(); i++)
 	{
-		K k = it->first;
-		C c = it->second;
-		Pair<K, C> p(k, c);
-		retIt->push_back(p);
+		if(ret.size() > 0) ret += SHUFFLETASK_KV_DELIMITATION;
+		ret += strFunc(pairs[i]);
 	}
-	combiners.clear();
+	return ret;
+}
 
-	// saving cache
-	this->shuffleCache[srp->partitionID] = retIt;
-	pthread_mutex_unlock(&this->shuffleMutexes[srp->partitionID]);
+/*
+ * to find partitions to split by map statuses, and split them.
+ * a partition is skewed if its map output, measured after map-side combine,
+ * is far larger than the median, such as a partition with many distinct keys,
+ * or values of hot keys that cannot be combined.
+ * if adaptive, a partition larger than the target size is split too.
+ * such a partition is combined by several ShuffledSliceTasks in parallel,
+ * each of which combines output of a range of map tasks,
+ * then iteratorSeq only merges the partial combiners.
+ */
+template <class K, class V, class C>
+void ShuffledRDD<K, V, C>::splitPartitions()
+{
+	int numTasks = this->mapStatuses.size();
+	if(numTasks <= 1) return;
+
+	vector<long> bytes = MapStatus::partitionBytes(this->mapStatuses, 0, numTasks);
+	long median = 0;
+	vector<int> partitionSlices = MapStatus::partitionSlices(bytes, this->adaptive,
+			this->context->getTotalThreads(), median);
+
+	vector< Task<string>* > tasks;
+	vector<int> slicePartitions;
+	for(int p = 0; p < (int)partitionSlices.size(); p++) {
+		int slices = partitionSlices[p];
+		if(slices > numTasks) slices = numTasks;
+		if(slices < 2) continue;
+
+		// contiguous ranges of map tasks, with about the same bytes
+		vector<int> starts;
+		MapStatus::splitTasks(this->mapStatuses, p, 0, numTasks, slices, starts);
+		if(starts.size() < 2) continue;
+		for(size_t r = 0; r < starts.size(); r++) {
+			int last = r + 1 < starts.size() ? starts[r + 1] : numTasks;
+			vector< pair<int, int> > range(1, make_pair(starts[r], last));
+			vector<string> locations = MapStatus::preferredHosts(this->mapStatuses, p, p + 1, range);
+			tasks.push_back(new ShuffledSliceTask<K, V, C>(this, p, starts[r], last, locations));
+			slicePartitions.push_back(p);
+		}
 
-	return retIt;
+		stringstream ss;
+		ss << "ShuffledRDD: partition [" << p << "] of shuffle [" << this->shuffleID << "] has "
+				<< bytes[p] << " bytes against median " << median
+				<< ", split into [" << starts.size() << "] slices";
+		Logging::logInfo(ss.str());
+	}
+	if(tasks.size() == 0) return;
+	VectorAutoPointer< Task<string> > auto_ptr1(tasks); // delete pointers automatically
+
+	// combine slices
+	vector< TaskResult<string>* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult<string> > auto_ptr2(results); // delete pointers automatically
+	for(unsigned int i = 0; i < results.size(); i++) {
+		slicedPartitions[slicePartitions[i]].push_back("");
+		slicedPartitions[slicePartitions[i]].back().swap(results[i]->value);
+	}
 }
 
 /*
@@ -278,61 +590,73 @@ namespace std {
 }
 
 /*
- * to merge combiners fetched from other nodes
+ * to merge serialized combiners, read from files or pushed by other nodes
  */
 template <class K, class V, class C>
-void ShuffledRDD<K, V, C>::merge(vector<string> &replys, unordered_map<K, C> &combiners)
+void ShuffledRDD<K, V, C>::merge(vector<string> &replys, FlatCombinerMap<K, C> &combiners)
 {
-	int invalid = 0;
-	typename unordered_map<K, C>::iterator iter;
+	ShuffleDataDecoder<K, V, C> decoder(this, combiners);
 	for(unsigned int i=0; i<replys.size(); i++)
 	{
-		vector<string> pairs;
-		splitString(replys[i], pairs, SHUFFLETASK_KV_DELIMITATION);
-		for(unsigned int j=0; j<pairs.size(); j++)
-		{
-			if(pairs[j] == string(SHUFFLETASK_EMPTY_DELIMITATION))
-				continue;
-
-			Pair<K, C> p;
-			try {
-				p = recoverFunc(pairs[j]);
-			} catch (std::bad_alloc& ba) {
-				invalid ++;
-				continue; // converting from string failed
-			}
-			if (!p.valid) {
-				invalid ++;
-				continue; // converting from string failed
-			}
-
-			iter = combiners.find(p.v1);
-			if(iter != combiners.end())
-			{
-				// the key exists
-				Pair<K, C> origin(p.v1, combiners[p.v1]);
-				Pair<K, C> newPair = agg.mergeCombiners(origin, p);
-				combiners[p.v1] = newPair.v2;
-			}
-			else
-			{
-				combiners[p.v1] = p.v2;
-			}
-		}
+		decoder.decode(replys[i].data(), replys[i].size());
+		decoder.finish();
 	}
-	if (invalid > 0) {
+	if (decoder.getInvalid() > 0) {
         stringstream ss;
-        ss << invalid << " invalid pairs found in ShuffledRDD::merge()";
+        ss << decoder.getInvalid() << " invalid pairs found in ShuffledRDD::merge()";
         Logging::logWarning(ss.str());
 	}
 }
 
 /*
- * for sub-class of Messaging, must override messageReceived
+ * thread function of threads helping to merge a reduce partition
+ */
+template <class K, class V, class C>
+void * xyz_shuffled_rdd_merge_thread_f(void *data)
+{
+	xyz_shuffled_rdd_merge_thread_data_<K, V, C> *td = (xyz_shuffled_rdd_merge_thread_data_<K, V, C> *)data;
+	td->rdd->mergeUnits(td->partitionID, *td->units, *td->next, td->mutex, td->combiners);
+	return NULL;
+}
+
+/*
+ * constructor of ShuffleDataDecoder
+ */
+template <class K, class V, class C>
+ShuffleDataDecoder<K, V, C>::ShuffleDataDecoder(ShuffledRDD<K, V, C> *rdd, FlatCombinerMap<K, C> &combiners)
+: RecordDecoder(SHUFFLETASK_KV_DELIMITATION), rdd(rdd), combiners(combiners), invalid(0) {
+}
+
+/*
+ * to merge a fetched combiner as soon as it is received
+ */
+template <class K, class V, class C>
+void ShuffleDataDecoder<K, V, C>::record(string &s)
+{
+	if(s == SHUFFLETASK_EMPTY_DELIMITATION || s == EMPTY_MESSAGE)
+		return;
+
+	Pair<K, C> p;
+	try {
+		p = rdd->recoverFunc(s);
+	} catch (std::bad_alloc& ba) {
+		invalid ++;
+		return; // converting from string failed
+	}
+	if (!p.valid) {
+		invalid ++;
+		return; // converting from string failed
+	}
+	combiners.merge(p, rdd->agg);
+}
+
+/*
+ * return number of records failed to convert
  */
 template <class K, class V, class C>
-void ShuffledRDD<K, V, C>::messageReceived(int localListenPort, string fromHost, int msgType, string &msg)
+int ShuffleDataDecoder<K, V, C>::getInvalid()
 {
+	return invalid;
 }
 
 #endif /* INCLUDE_SHUFFLEDRDD_HPP_ */
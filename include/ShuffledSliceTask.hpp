@@ -0,0 +1,57 @@
+/*
+ * ShuffledSliceTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SHUFFLEDSLICETASK_HPP_
+#define INCLUDE_SHUFFLEDSLICETASK_HPP_
+
+#include "ShuffledSliceTask.h"
+
+#include "Task.hpp"
+#include "ShuffledRDD.hpp"
+
+/*
+ * constructor
+ */
+template <class K, class V, class C>
+ShuffledSliceTask<K, V, C>::ShuffledSliceTask(ShuffledRDD<K, V, C> *r, int partitionID,
+		int firstTask, int lastTask, vector<string> &locations)
+: rdd(r), partitionID(partitionID), firstTask(firstTask), lastTask(lastTask), locations(locations)
+{
+}
+
+/*
+ * to merge combiners of the partition written by the map tasks
+ */
+template <class K, class V, class C>
+string ShuffledSliceTask<K, V, C>::run() {
+	return rdd->combineSlice(partitionID, firstTask, lastTask);
+}
+
+/*
+ * the result is serialized already
+ */
+template <class K, class V, class C>
+string ShuffledSliceTask<K, V, C>::serialize(string &t) {
+	return t;
+}
+
+/*
+ * the result is kept serialized
+ */
+template <class K, class V, class C>
+string ShuffledSliceTask<K, V, C>::deserialize(string &s) {
+	return s;
+}
+
+/*
+ * to run near the map tasks
+ */
+template <class K, class V, class C>
+vector<string> ShuffledSliceTask<K, V, C>::preferredLocations() {
+	return locations;
+}
+
+#endif /* INCLUDE_SHUFFLEDSLICETASK_HPP_ */
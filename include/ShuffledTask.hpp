@@ -18,12 +18,24 @@
 #include "Aggregator.hpp"
 #include "HashDivider.hpp"
 #include "Utils.hpp"
+#include "Logging.hpp"
 #include "DataCache.hpp"
 #include "VectorIteratorSeq.hpp"
+#include "Messaging.hpp"
+#include "MapStatus.hpp"
+#include "MemoryGovernor.hpp"
+#include "MessageDecoder.hpp"
+#include "TaskScheduler.hpp"
 
 #include <vector>
+#include <map>
 #include <string>
 #include <fstream>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
 /*
@@ -35,13 +47,26 @@ template <class T, class U> ShuffledTask<T, U>::ShuffledTask(
 		Aggregator<T, U> &aggregator,
 		long (*hFunc)(U &u),
 		string (*sf)(U &u))
-:RDDTask< T, int >::RDDTask(r, p), hd(hashDivider), agg(aggregator)
+:RDDTask< T, MapStatus >::RDDTask(r, p), hd(hashDivider), agg(aggregator)
 {
 	shuffleID = shID;
     numPartitions = nPs;
 	hashFunc = hFunc;
 	strFunc = sf;
 
+	outputToFile = false;
+	pushMessenger = NULL;
+	pushPort = 0;
+	mappedOutput = NULL;
+	mappedSize = 0;
+	outputReady = false;
+	usedMemory = 0;
+	keptMemory = 0;
+	pthread_mutex_init(&outputMutex, NULL);
+	// files of different applications on the same host are kept apart by pid
+	outputPath = XYZ_SHUFFLE_OUTPUT_DIR + to_string((long)getpid())
+			+ "/shuffle_" + to_string(shuffleID) + "_" + to_string(this->taskID);
+
     for(int i = 0; i < numPartitions; i++)
     {
     	partitions.push_back(new VectorIteratorSeq<U>());
@@ -57,6 +82,17 @@ template <class T, class U> ShuffledTask<T, U>::~ShuffledTask() {
 		delete partitions[i];
 	}
 	partitions.clear();
+
+	if(mappedOutput != NULL) {
+		munmap(mappedOutput, mappedSize);
+	}
+	XYZ_MEMORY_GOVERNOR.releaseAcquired(keptMemory);
+	if(outputToFile) {
+		unlink((outputPath + ".data").c_str());
+		unlink((outputPath + ".index").c_str());
+		rmdir(outputPath.substr(0, outputPath.rfind('/')).c_str()); // only if empty
+	}
+	pthread_mutex_destroy(&outputMutex);
 }
 
 /*
@@ -64,42 +100,235 @@ template <class T, class U> ShuffledTask<T, U>::~ShuffledTask() {
  * this are several things:
  *   1) create combiners for each element in the partition
  *   2) by hash of each element, choose the new partition index of each element
+ *   3) serialize all partitions into the output buffer
+ *   4) push partitions to reduce hosts if required
+ *   5) write the output buffer to local files if required, or if it does not fit in memory
  *
- * return 1
+ * return MapStatus with sizes of new partitions
  */
-template <class T, class U> int ShuffledTask<T, U>::run()
+template <class T, class U> MapStatus ShuffledTask<T, U>::run()
 {
+	status = MapStatus(numPartitions);
+	status.host = getLocalHost();
+
 	// get current RDD value
-	IteratorSeq<T> *seq = RDDTask< T, int >::rdd->iteratorSeq(RDDTask< T, int >::partition);
+	IteratorSeq<T> *seq = RDDTask< T, MapStatus >::rdd->getOrCompute(RDDTask< T, MapStatus >::partition);
     for(size_t i = 0; i < seq->size(); i++) {
     	T t = seq->at(i);
     	U data = agg.createCombiner(t);
-		long hashCode = hashFunc(data);
-		int part = hd.getPartition(hashCode); // get the new partition index
-		partitions[part]->push_back(data);
+		int part = this->choosePartition(data); // get the new partition index
+		this->addToPartition(part, data);
+    }
+    this->finishPartitions();
+    this->serializePartitions();
+    for(int i = 0; i < numPartitions; i++) { // add to what finishPartitions counted
+    	status.records[i] += partitions[i]->size();
+    	status.bytes[i] += outputIndex[i + 1] - outputIndex[i];
+    }
+    // only the serialized output is kept, local reduce tasks read it like fetched data
+    for(int i = 0; i < numPartitions; i++) {
+    	vector<U> released;
+    	partitions[i]->swap(released);
     }
+    if(pushMessenger != NULL) {
+    	this->pushPartitions();
+    }
+
+    // output is spilled to local files if it does not fit in the memory budget.
+    usedMemory = output.size();
+    if(!outputToFile) {
+    	if(XYZ_MEMORY_GOVERNOR.acquire(usedMemory)) {
+    		keptMemory = usedMemory;
+    	} else {
+    		Logging::logInfo("ShuffledTask: memory budget exceeded, output spilled to " + outputPath);
+    		outputToFile = true;
+    	}
+    }
+    if(outputToFile && !this->writeOutputFiles()) {
+    	if(XYZ_TASK_SCHEDULER_RUN_TASK_MODE == 0) {
+    		status.failed = true; // a forked task cannot log, nor keep its output in memory
+    		return status;
+    	}
+    	Logging::logError("ShuffledTask: failed to write shuffle output files " + outputPath
+    			+ ", output kept in memory");
+    	outputToFile = false;
+    }
+    if(!outputToFile) {
+    	pthread_mutex_lock(&outputMutex);
+    	outputReady = true;
+    	pthread_mutex_unlock(&outputMutex);
+    }
+
+	return status;
+}
+
+/*
+ * to choose the new partition index of a combiner by its hash code.
+ */
+template <class T, class U>
+int ShuffledTask<T, U>::choosePartition(U &u) {
+	return hd.getPartition(hashFunc(u));
+}
+
+/*
+ * to add a combiner to a new partition.
+ * sub-classes may combine it with others here.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::addToPartition(int part, U &u) {
+	partitions[part]->push_back(u);
+}
+
+/*
+ * nothing to do after partitioning by hash.
+ * sub-classes may reorganize partition data here.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::finishPartitions() {
+}
+
+/*
+ * serializing each element in every partition once, after the task finished.
+ * fetch requests are served from this buffer directly.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::serializePartitions() {
+	const string delimitation = SHUFFLETASK_KV_DELIMITATION;
+	output.clear();
+	outputIndex.assign(numPartitions + 1, 0);
+	for(int i = 0; i < numPartitions; i++) {
+		outputIndex[i] = output.size();
+		size_t n = partitions[i]->size();
+		for(size_t j = 0; j < n; j++) {
+			if(j > 0) output += delimitation;
+			U u = partitions[i]->at(j);
+			output += strFunc(u);
+		}
+	}
+	outputIndex[numPartitions] = output.size();
+}
+
+/*
+ * to send partitions to the hosts their reduce tasks will run on,
+ * one message per host. partitions of this host are not sent.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::pushPartitions() {
+	string self = getLocalHost();
+	map< string, vector<int> > hostPartitions;
+	for(int i = 0; i < numPartitions && (size_t)i < pushHosts.size(); i++) {
+		if(pushHosts[i] != self) {
+			hostPartitions[pushHosts[i]].push_back(i);
+		}
+	}
+
+	map< string, vector<int> >::iterator it;
+	for(it = hostPartitions.begin(); it != hostPartitions.end(); ++it) {
+		string msg = to_string(shuffleID) + "," + to_string(this->taskID);
+		for(size_t i = 0; i < it->second.size(); i++) {
+			// read from the buffer directly, output is not published yet
+			int part = it->second[i];
+			msg += SHUFFLE_PUSH_DELIMITATION;
+			msg += to_string(part);
+			msg += SHUFFLE_PUSH_DELIMITATION;
+			if(outputIndex[part + 1] > outputIndex[part]) {
+				msg.append(output, outputIndex[part], outputIndex[part + 1] - outputIndex[part]);
+			} else {
+				msg += SHUFFLETASK_EMPTY_DELIMITATION;
+			}
+		}
+		pushMessenger->sendMessage(it->first, pushPort, SHUFFLE_PUSH, msg);
+	}
+}
+
+/*
+ * to write the output buffer and its index to local files,
+ * then release the memory of the buffer.
+ * the index file is renamed into place last, so it marks finished output.
+ * only system calls are used, as forked tasks write their output here.
+ * return false if the files cannot be written.
+ */
+template <class T, class U>
+bool ShuffledTask<T, U>::writeOutputFiles() {
+	string dir = outputPath.substr(0, outputPath.rfind('/') + 1);
+	mkdirRecursive(dir.c_str());
+
+	string indexPath = outputPath + ".index";
+	string tmpPath = indexPath + ".tmp";
+	if(!writeRawFile(outputPath + ".data", output.data(), output.size())
+			|| !writeRawFile(tmpPath, (const char *)&outputIndex[0], outputIndex.size() * sizeof(size_t))
+			|| rename(tmpPath.c_str(), indexPath.c_str()) != 0) {
+		return false;
+	}
+
+	string().swap(output);
+	outputIndex.clear();
+	return true;
+}
+
+/*
+ * to load the index file and map the data file of this task.
+ * return false if this task has not written its output on this node.
+ */
+template <class T, class U>
+bool ShuffledTask<T, U>::loadOutputFiles() {
+	if(!outputToFile) return false;
+
+	pthread_mutex_lock(&outputMutex);
+	if(outputReady) {
+		pthread_mutex_unlock(&outputMutex);
+		return true; // loaded before
+	}
+
+	vector<size_t> index(numPartitions + 1, 0);
+	ifstream indexFile((outputPath + ".index").c_str(), ios::in | ios::binary);
+	if(!indexFile.is_open()
+		|| !indexFile.read((char *)&index[0], index.size() * sizeof(size_t))) {
+		pthread_mutex_unlock(&outputMutex);
+		return false; // not run on this node, or not finished
+	}
+	indexFile.close();
 
-	return 1;
+	size_t size = index[numPartitions];
+	if(size > 0) {
+		int fd = open((outputPath + ".data").c_str(), O_RDONLY);
+		void *addr = MAP_FAILED;
+		if(fd >= 0) {
+			addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			close(fd);
+		}
+		if(addr == MAP_FAILED) {
+			pthread_mutex_unlock(&outputMutex);
+			Logging::logError("ShuffledTask: failed to map shuffle output file " + outputPath);
+			return false;
+		}
+		mappedOutput = (char *)addr;
+		mappedSize = size;
+	}
+	outputIndex = index;
+	outputReady = true;
+	pthread_mutex_unlock(&outputMutex);
+	return true;
+}
+
+/*
+ * return the serialized output, in memory or mapped from file
+ */
+template <class T, class U>
+const char * ShuffledTask<T, U>::outputData() {
+	if(mappedOutput != NULL) return mappedOutput;
+	return output.data();
 }
 
 /*
  * return combiners data of requested partition.
- * serializing each element in the partition.
+ * return SHUFFLETASK_EMPTY_DELIMITATION if the partition is empty.
  */
 template <class T, class U>
 void ShuffledTask<T, U>::getData(long cacheIndex, string &result) {
-	result = "";
-	if(cacheIndex >= 0
-		&& cacheIndex < numPartitions
-		&& partitions[cacheIndex]->size() > 0) {
-			size_t n = partitions[cacheIndex]->size();
-			for(size_t i = 0; i < n - 1; i++) {
-				U u = partitions[cacheIndex]->at(i);
-				result += strFunc(u);
-				result += string(SHUFFLETASK_KV_DELIMITATION);
-			}
-			U u = partitions[cacheIndex]->at(n - 1);
-			result += strFunc(u);
+	if(getDataSize(cacheIndex) > 0) {
+		result.assign(outputData() + outputIndex[cacheIndex],
+				outputIndex[cacheIndex + 1] - outputIndex[cacheIndex]);
 	}
 	else {
 		result = SHUFFLETASK_EMPTY_DELIMITATION;
@@ -107,22 +336,100 @@ void ShuffledTask<T, U>::getData(long cacheIndex, string &result) {
 }
 
 /*
- * get combiners data of a partition
+ * return bytes of serialized combiners of requested partition
  */
 template <class T, class U>
-IteratorSeq<U> * ShuffledTask<T, U>::getPartitionData(int partition) {
-	if(partition < 0 || partition >= numPartitions) {
-		return NULL;
+size_t ShuffledTask<T, U>::getDataSize(long cacheIndex) {
+	if(cacheIndex < 0 || cacheIndex >= numPartitions) {
+		return 0;
 	}
-	else {
-		return partitions[partition];
+	if(!hasOutput()) {
+		return 0; // not run on this node
+	}
+	return outputIndex[cacheIndex + 1] - outputIndex[cacheIndex];
+}
+
+/*
+ * append serialized combiners of requested partition to result
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::appendData(long cacheIndex, string &result) {
+	size_t size = getDataSize(cacheIndex);
+	if(size > 0) {
+		result.append(outputData() + outputIndex[cacheIndex], size);
+	}
+}
+
+/*
+ * append bytes [offset, offset + length) of serialized combiners of requested partition to result
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::appendData(long cacheIndex, size_t offset, size_t length, string &result) {
+	size_t size = getDataSize(cacheIndex);
+	if(offset < size) {
+		if(length > size - offset) length = size - offset;
+		result.append(outputData() + outputIndex[cacheIndex] + offset, length);
 	}
 }
 
+/*
+ * to decode serialized combiners of requested partition from the output buffer,
+ * without copying them out first
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::decodeData(long cacheIndex, MessageDecoder &decoder) {
+	size_t size = getDataSize(cacheIndex);
+	if(size > 0) {
+		decoder.decode(outputData() + outputIndex[cacheIndex], size);
+		decoder.finish();
+	}
+}
+
+/*
+ * whether to write output to local files when running.
+ * must be set before running.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::setOutputToFile(bool toFile) {
+	outputToFile = toFile;
+}
+
+/*
+ * to push partitions to reduce hosts when running.
+ * hosts[i] is the host where the reduce task of partition i will run.
+ */
+template <class T, class U>
+void ShuffledTask<T, U>::setPushTargets(Messaging *messenger, vector<string> &hosts, int port) {
+	pushMessenger = messenger;
+	pushHosts = hosts;
+	pushPort = port;
+}
+
+/*
+ * whether this task has run on this node.
+ * output in memory is published under outputMutex when the task finishes,
+ * output in files is loaded the first time it is asked for.
+ */
+template <class T, class U>
+bool ShuffledTask<T, U>::hasOutput() {
+	pthread_mutex_lock(&outputMutex);
+	bool ready = outputReady;
+	pthread_mutex_unlock(&outputMutex);
+	return ready || loadOutputFiles();
+}
+
+/*
+ * working set of the task after running
+ */
+template <class T, class U>
+size_t ShuffledTask<T, U>::memoryUsed() {
+	return usedMemory;
+}
+
 /*
  * serializing the result of ShuffledTask
  */
-template <class T, class U> string ShuffledTask<T, U>::serialize(int &t)
+template <class T, class U> string ShuffledTask<T, U>::serialize(MapStatus &t)
 {
 	return to_string(t);
 }
@@ -130,9 +437,9 @@ template <class T, class U> string ShuffledTask<T, U>::serialize(int &t)
 /*
  * deserializing a string to task result
  */
-template <class T, class U> int ShuffledTask<T, U>::deserialize(string &s)
+template <class T, class U> MapStatus ShuffledTask<T, U>::deserialize(string &s)
 {
-	int val = 0;
+	MapStatus val;
 	from_string(val, s);
 	return val;
 }
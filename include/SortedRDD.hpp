@@ -0,0 +1,301 @@
+/*
+ * SortedRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SORTEDRDD_HPP_
+#define INCLUDE_SORTEDRDD_HPP_
+
+#include "SortedRDD.h"
+
+#include <cmath>
+#include <map>
+#include <new>
+#include <queue>
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "ShuffledPartition.hpp"
+#include "BaseShuffledRDD.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "SunwayMRContext.hpp"
+#include "SortedTask.hpp"
+#include "SampleTask.hpp"
+#include "MessageDecoder.hpp"
+#include "Aggregator.hpp"
+#include "HashDivider.hpp"
+#include "RangeDivider.hpp"
+#include "TaskResult.hpp"
+#include "Task.hpp"
+#include "Messaging.hpp"
+#include "Utils.hpp"
+#include "TaskScheduler.hpp"
+#include "VectorAutoPointer.hpp"
+
+using namespace std;
+
+#ifndef SORTED_RDD_SAMPLES_PER_PARTITION
+#define SORTED_RDD_SAMPLES_PER_PARTITION 60 // keys sampled for each new partition
+#endif
+
+/*
+ * create combiner for SortedTask, pairs are not combined when sorting
+ */
+template <class K, class V>
+Pair<K, V> xyz_sorted_rdd_create_combiner_f(Pair<K, V> &p) {
+	return p;
+}
+
+/*
+ * heap order of run heads used by SortedRDD::mergeRuns.
+ * a run head is (run index, position in run).
+ */
+template <class K, class V>
+struct xyz_sorted_rdd_run_head_order_ {
+	vector< vector< Pair<K, V> > > *runs;
+	bool ascending;
+
+	xyz_sorted_rdd_run_head_order_(vector< vector< Pair<K, V> > > *runs, bool ascending)
+	: runs(runs), ascending(ascending) { }
+
+	// priority_queue pops the greatest element, so "greater" keys get the lower priority when ascending
+	bool operator()(const pair<size_t, size_t> &h1, const pair<size_t, size_t> &h2) const {
+		const K &k1 = (*runs)[h1.first][h1.second].v1;
+		const K &k2 = (*runs)[h2.first][h2.second].v1;
+		if (ascending) return k2 < k1;
+		return k1 < k2;
+	}
+};
+
+/*
+ * constructor
+ */
+template <class K, class V>
+SortedRDD<K, V>::SortedRDD(RDD< Pair<K, V> > *_prevRDD,
+		int numPartitions,
+		bool ascending,
+		string (*strf)(Pair<K, V> &p),
+		Pair<K, V> (*_recoverFunc)(string &s))
+: BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, V> >::BaseShuffledRDD(_prevRDD, HashDivider(numPartitions), "SortedRDD"),
+  rd(numPartitions, ascending),
+  agg(xyz_sorted_rdd_create_combiner_f<K, V>, NULL)
+{
+	strFunc = strf;
+	recoverFunc = _recoverFunc;
+	prevPersisted = false;
+	prevSticky = false;
+
+	// construct sort tasks
+	vector<Partition*> pars = this->prevRDD->getPartitions(); //partitions before shuffle
+	for (unsigned int i = 0; i < pars.size(); i++)
+	{
+		SortedTask<K, V> *task =
+				new SortedTask<K, V>(
+						this->prevRDD, pars[i], this->shuffleID, numPartitions,
+						this->hd, agg, strFunc, &rd);
+		this->shuffledTasks.push_back(task);
+	}
+}
+
+/*
+ * to choose bounds of key ranges.
+ * a cheap job samples keys from every partition of previous RDD,
+ * every node receives the same samples and chooses the same bounds.
+ */
+template <class K, class V>
+void SortedRDD<K, V>::sample()
+{
+	vector<Partition*> pars = this->prevRDD->getPartitions();
+	if (pars.size() == 0 || rd.getNumPartitions() <= 1) return;
+
+	size_t sampleSize = (size_t)ceil(
+			(double)SORTED_RDD_SAMPLES_PER_PARTITION * rd.getNumPartitions() / pars.size());
+
+	vector< Task< vector<K> >* > tasks;
+	for (unsigned int i = 0; i < pars.size(); i++) {
+		tasks.push_back(new SampleTask<K, V>(this->prevRDD, pars[i], sampleSize));
+	}
+	VectorAutoPointer< Task< vector<K> > > auto_ptr1(tasks); // delete pointers automatically
+
+	vector< TaskResult< vector<K> >* > results = this->context->runTasks(tasks);
+	VectorAutoPointer< TaskResult< vector<K> > > auto_ptr2(results); // delete pointers automatically
+
+	vector<K> samples;
+	for (unsigned int i = 0; i < results.size(); i++) {
+		samples.insert(samples.end(), results[i]->value.begin(), results[i]->value.end());
+	}
+	rd.setBounds(samples);
+}
+
+/*
+ * to sample keys of the previous RDD before SortedTasks run.
+ * the previous RDD is persisted while shuffling, unless it is already,
+ * so the sampling job and the map tasks compute its partitions only once.
+ * in files if tasks are forked, as memory of child processes is lost.
+ */
+template <class K, class V>
+void SortedRDD<K, V>::beforeMapStage(bool toFile)
+{
+	if (rd.getNumPartitions() > 1 && this->prevRDD->getStorageLevel() == STORAGE_NONE) {
+		prevSticky = this->prevRDD->isSticky();
+		prevPersisted = true;
+		this->prevRDD->persist(XYZ_TASK_SCHEDULER_RUN_TASK_MODE == 0 ? STORAGE_DISK_ONLY : STORAGE_MEMORY_ONLY);
+	}
+	sample();
+}
+
+/*
+ * to drop the previous RDD persisted by beforeMapStage
+ */
+template <class K, class V>
+void SortedRDD<K, V>::afterMapStage()
+{
+	if (prevPersisted) {
+		this->prevRDD->unpersist();
+		this->prevRDD->setSticky(prevSticky);
+		prevPersisted = false;
+	}
+	BaseShuffledRDD< K, V, Pair<K, V>, Pair<K, V> >::afterMapStage();
+}
+
+/*
+ * to get data set of a partition.
+ * this is done by several steps:
+ *   1) to decode serialized sorted runs of local SortedTasks
+ *   2) to fetch sorted runs from other nodes, decoded while received
+ *   3) to merge all runs, save cache and return the sorted IteratorSeq
+ */
+template <class K, class V>
+IteratorSeq< Pair<K, V> > * SortedRDD<K, V>::iteratorSeq(Partition *p)
+{
+	ShuffledPartition *srp = dynamic_cast<ShuffledPartition * >(p);
+
+	// checking cache
+	IteratorSeq< Pair<K, V> > *cached = this->lockPartition(srp);
+	if (cached != NULL) {
+		return cached;
+	}
+
+	// local runs are decoded in place, fetched runs while received.
+	// runs of adjacent ranges of a coalesced partition are merged as well.
+	vector< vector< Pair<K, V> > > runs;
+	SortedRunDecoder<K, V> decoder(this, runs);
+	for(int part = srp->firstPartition; part < srp->lastPartition; part++) {
+		for(size_t i = 0; i < this->shuffledTasks.size(); i++) {
+			this->shuffledTasks[i]->decodeData(part, decoder);
+		}
+
+		// fetch
+		vector<string> IPs = (this->context)->getHosts();
+		int port = (this->context)->getListenPort();
+		this->fetchShuffleData(IPs, port, this->shuffleID, part, -1, -1, decoder);
+	}
+	if (decoder.getInvalid() > 0) {
+		stringstream ss;
+		ss << decoder.getInvalid() << " invalid pairs found in SortedRDD::iteratorSeq()";
+		Logging::logWarning(ss.str());
+	}
+
+	// merge runs
+	VectorIteratorSeq< Pair<K, V> > *retIt = new VectorIteratorSeq< Pair<K, V> >();
+	mergeRuns(runs, *retIt);
+
+	// saving cache
+	this->unlockPartition(srp, retIt);
+
+	return retIt;
+}
+
+/*
+ * k-way merge of sorted runs with a heap of run heads
+ */
+template <class K, class V>
+void SortedRDD<K, V>::mergeRuns(vector< vector< Pair<K, V> > > &runs, VectorIteratorSeq< Pair<K, V> > &result)
+{
+	size_t total = 0;
+	for(size_t i = 0; i < runs.size(); i++) {
+		total += runs[i].size();
+	}
+	result.reserve(total);
+
+	xyz_sorted_rdd_run_head_order_<K, V> order(&runs, rd.isAscending());
+	priority_queue< pair<size_t, size_t>,
+			vector< pair<size_t, size_t> >,
+			xyz_sorted_rdd_run_head_order_<K, V> > heads(order);
+	for(size_t i = 0; i < runs.size(); i++) {
+		if(runs[i].size() > 0) heads.push(make_pair(i, (size_t)0));
+	}
+	while(!heads.empty()) {
+		pair<size_t, size_t> head = heads.top();
+		heads.pop();
+		result.push_back(runs[head.first][head.second]);
+		if(head.second + 1 < runs[head.first].size()) {
+			heads.push(make_pair(head.first, head.second + 1));
+		}
+	}
+	runs.clear();
+}
+
+/*
+ * constructor of SortedRunDecoder
+ */
+template <class K, class V>
+SortedRunDecoder<K, V>::SortedRunDecoder(SortedRDD<K, V> *rdd, vector< vector< Pair<K, V> > > &runs)
+: RecordDecoder(SHUFFLETASK_KV_DELIMITATION), rdd(rdd), runs(runs), newRun(true), invalid(0) {
+}
+
+/*
+ * to append a pair to the current run, or to start a new run if the order of keys breaks
+ */
+template <class K, class V>
+void SortedRunDecoder<K, V>::record(string &s)
+{
+	if(s == SHUFFLETASK_EMPTY_DELIMITATION || s == EMPTY_MESSAGE)
+		return;
+
+	Pair<K, V> p;
+	try {
+		p = rdd->recoverFunc(s);
+	} catch (std::bad_alloc& ba) {
+		invalid ++;
+		return; // converting from string failed
+	}
+	if (!p.valid) {
+		invalid ++;
+		return; // converting from string failed
+	}
+
+	if (!newRun) {
+		K &last = runs.back().back().v1;
+		newRun = rdd->rd.isAscending() ? (p.v1 < last) : (last < p.v1);
+	}
+	if (newRun) {
+		runs.push_back(vector< Pair<K, V> >());
+		newRun = false;
+	}
+	runs.back().push_back(p);
+}
+
+/*
+ * the next message starts a new run
+ */
+template <class K, class V>
+void SortedRunDecoder<K, V>::finish()
+{
+	RecordDecoder::finish();
+	newRun = true;
+}
+
+/*
+ * return number of records failed to convert
+ */
+template <class K, class V>
+int SortedRunDecoder<K, V>::getInvalid()
+{
+	return invalid;
+}
+
+#endif /* INCLUDE_SORTEDRDD_HPP_ */
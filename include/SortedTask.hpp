@@ -0,0 +1,68 @@
+/*
+ * SortedTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_SORTEDTASK_HPP_
+#define INCLUDE_SORTEDTASK_HPP_
+
+#include "SortedTask.h"
+
+#include "ShuffledTask.hpp"
+#include "RangeDivider.hpp"
+#include "Pair.hpp"
+
+/*
+ * compare pairs by keys in ascending order
+ */
+template <class K, class V>
+bool xyz_sorted_task_key_less_f(const Pair<K, V> &p1, const Pair<K, V> &p2) {
+	return p1.v1 < p2.v1;
+}
+
+/*
+ * compare pairs by keys in descending order
+ */
+template <class K, class V>
+bool xyz_sorted_task_key_greater_f(const Pair<K, V> &p1, const Pair<K, V> &p2) {
+	return p2.v1 < p1.v1;
+}
+
+/*
+ * constructor
+ */
+template <class K, class V>
+SortedTask<K, V>::SortedTask(RDD< Pair<K, V> > *r, Partition *p, long shID, int nPs,
+		HashDivider &hashDivider,
+		Aggregator< Pair<K, V>, Pair<K, V> > &aggregator,
+		string (*sf)(Pair<K, V> &p),
+		RangeDivider<K> *rangeDivider)
+: ShuffledTask< Pair<K, V>, Pair<K, V> >::ShuffledTask(r, p, shID, nPs, hashDivider, aggregator, NULL, sf),
+  rd(rangeDivider)
+{
+}
+
+/*
+ * to choose the new partition index by the range the key falls in
+ */
+template <class K, class V>
+int SortedTask<K, V>::choosePartition(Pair<K, V> &p) {
+	return rd->getPartition(p.v1);
+}
+
+/*
+ * to sort each new partition by key
+ */
+template <class K, class V>
+void SortedTask<K, V>::finishPartitions() {
+	for(size_t i = 0; i < this->partitions.size(); i++) {
+		if(rd->isAscending()) {
+			this->partitions[i]->sort(xyz_sorted_task_key_less_f<K, V>);
+		} else {
+			this->partitions[i]->sort(xyz_sorted_task_key_greater_f<K, V>);
+		}
+	}
+}
+
+#endif /* INCLUDE_SORTEDTASK_HPP_ */
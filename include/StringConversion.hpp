@@ -18,6 +18,7 @@
 #include "Pair.hpp"
 #include "Either.hpp"
 #include "FileSource.hpp"
+#include "MapStatus.hpp"
 using namespace std;
 
 /// to_string
@@ -183,6 +184,23 @@ string to_string(const FileSource &fs) {
 	return ret;
 }
 
+string to_string(const MapStatus &ms) {
+	string ret = ms.host;
+	ret += MAP_STATUS_DELIMITATION;
+	for (size_t i = 0; i < ms.records.size(); i++) {
+		if (i > 0) ret += ",";
+		ret += to_string(ms.records[i]);
+	}
+	ret += MAP_STATUS_DELIMITATION;
+	for (size_t i = 0; i < ms.bytes.size(); i++) {
+		if (i > 0) ret += ",";
+		ret += to_string(ms.bytes[i]);
+	}
+	ret += MAP_STATUS_DELIMITATION;
+	ret += to_string(ms.failed);
+	return ret;
+}
+
 /// from_string
 
 void from_string(bool &v, string s) {
@@ -317,5 +335,20 @@ void from_string(FileSource &fs, string s) {
 	}
 }
 
+void from_string(MapStatus &ms, string s) {
+	vector<string> vs;
+	splitString(s, vs, MAP_STATUS_DELIMITATION);
+	ms = MapStatus();
+	if (vs.size() >= 1) ms.host = vs[0];
+	if (vs.size() >= 3) {
+		vector<string> rs, bs;
+		splitString(vs[1], rs, ",");
+		splitString(vs[2], bs, ",");
+		for (size_t i = 0; i < rs.size(); i++) ms.records.push_back(atol(rs[i].c_str()));
+		for (size_t i = 0; i < bs.size(); i++) ms.bytes.push_back(atol(bs[i].c_str()));
+	}
+	if (vs.size() >= 4) from_string(ms.failed, vs[3]);
+}
+
 
 #endif /* INCLUDE_STRINGCONVERSION_HPP_ */
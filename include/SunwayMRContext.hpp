@@ -266,6 +266,13 @@ int SunwayMRContext::getTotalThreads() {
 	return scheduler->totalThreads();
 }
 
+/*
+ * to get the hosts that tasks without preferred locations will run on
+ */
+vector<string> SunwayMRContext::getTaskHosts(int taskNum) {
+	return scheduler->getTaskHosts(taskNum);
+}
+
 /*
  * save shuffle cache
  */
@@ -273,4 +280,39 @@ void SunwayMRContext::saveShuffleCache(long shuffleID, DataCache *cache) {
 	this->scheduler->saveShuffleCache(shuffleID, cache);
 }
 
+/*
+ * release shuffle cache before it is destroyed
+ */
+void SunwayMRContext::releaseShuffleCache(long shuffleID) {
+	this->scheduler->releaseShuffleCache(shuffleID);
+}
+
+/*
+ * keep a file cached while an RDD reads it
+ */
+void SunwayMRContext::retainFileCache(string path) {
+	this->scheduler->retainFileCache(path);
+}
+
+/*
+ * a file is not read by an RDD anymore
+ */
+void SunwayMRContext::releaseFileCache(string path) {
+	this->scheduler->releaseFileCache(path);
+}
+
+/*
+ * to take shuffle data pushed to this node
+ */
+void SunwayMRContext::takePushedShuffleData(long shuffleID, int partitionID, map<long, string> &blocks) {
+	this->scheduler->takePushedShuffleData(shuffleID, partitionID, blocks);
+}
+
+/*
+ * clear shuffle data pushed to this node
+ */
+void SunwayMRContext::clearPushedShuffleData(long shuffleID) {
+	this->scheduler->clearPushedShuffleData(shuffleID);
+}
+
 #endif /* SUNWAYMRCONTEXT_HPP_ */
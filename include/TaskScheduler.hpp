@@ -22,6 +22,7 @@
 #include "Task.hpp"
 #include "TaskResult.hpp"
 #include "StringConversion.hpp"
+#include "MemoryGovernor.hpp"
 
 using namespace std;
 
@@ -44,12 +45,17 @@ TaskScheduler<T>::TaskScheduler(int jobID, string selfIP, int selfIPIndex,
 		isMaster = 1;
 	}
 	runningThreadNum = 0;
+	waitingTaskNum = 0;
 	allTaskResultsReceived = false;
 	taskResultListSent = false;
 	receivedTaskResultNum = 0;
 	pthread_mutex_init(&mutex_handle_message_ready, NULL); // initialize mutex
 	pthread_mutex_lock(&mutex_handle_message_ready);
 	pthread_mutex_init(&mutex_task_scheduler, NULL); // initialize mutex
+	pthread_cond_init(&cond_task_memory, NULL);
+	pthread_mutex_init(&mutex_result_strings, NULL);
+	pthread_cond_init(&cond_result_strings, NULL);
+	memoryReleasedNum = 0;
 }
 
 /*
@@ -57,7 +63,9 @@ TaskScheduler<T>::TaskScheduler(int jobID, string selfIP, int selfIPIndex,
  */
 template<class T>
 TaskScheduler<T>::~TaskScheduler() {
-
+	pthread_cond_destroy(&cond_task_memory);
+	pthread_cond_destroy(&cond_result_strings);
+	pthread_mutex_destroy(&mutex_result_strings);
 }
 
 /*
@@ -89,12 +97,54 @@ void *xyz_task_scheduler_run_task_(void *d) {
 	struct xyz_task_scheduler_thread_data_<T> *data = (struct xyz_task_scheduler_thread_data_<T> *) d;
 	TaskScheduler<T> *ts = data->taskScheduler;
 	Task<T> *task = data->task;
+	Scheduler::setCurrent(ts); // the task may reserve helper threads
 	T value = task->run();
 	ts->finishTask(data->taskID, value);
 
 	pthread_exit(NULL);
 }
 
+/*
+ * thread data for sending the task result list to a node
+ */
+template<class T>
+struct xyz_task_scheduler_send_data_ {
+	TaskScheduler<T> *taskScheduler;
+	string host;
+	int port;
+	int jobID;
+
+	xyz_task_scheduler_send_data_(TaskScheduler<T> *t, string h, int p, int ji) :
+			taskScheduler(t), host(h), port(p), jobID(ji) {
+	}
+};
+
+/*
+ * thread function for sending the task result list to a node.
+ * every node is sent in a separate thread, so that a slow node does not hold up the others.
+ */
+template<class T>
+void *xyz_task_scheduler_send_result_list_(void *d) {
+	struct xyz_task_scheduler_send_data_<T> *data = (struct xyz_task_scheduler_send_data_<T> *) d;
+	TaskScheduler<T> *ts = data->taskScheduler;
+	bool ok = false;
+	int sockfd = ts->beginMessage(data->host, data->port, TASK_RESULT_LIST);
+	if (sockfd >= 0) {
+		ChunkedWriter writer(sockfd);
+		ts->writeTaskResultList(data->jobID, writer);
+		ok = writer.flush();
+		ok = ts->endMessage(sockfd) && ok;
+	} else {
+		ts->skipTaskResultList(data->jobID); // not to keep the results shared with other senders
+	}
+	if (!ok) {
+		Logging::logError("TaskScheduler: master: failed to send task result list to " + data->host);
+	}
+	delete data;
+
+	return NULL;
+}
+
 /*
  * before running tasks, do preparation work
  */
@@ -112,6 +162,8 @@ void TaskScheduler<T>::preRunTasks(vector< Task<T> * > &tasks) {
 	receivedTaskResultNum = 0;
 	resultReceived = vector<bool>(taskNum, false);
 	taskResults = vector< TaskResult<T>* >(taskNum, NULL);
+	taskMemory = vector<size_t>(taskNum, 0);
+	memoryPerTask = 0;
 
 	pthread_mutex_init(&mutex_all_tasks_received, NULL);
 	pthread_mutex_lock(&mutex_all_tasks_received);
@@ -193,6 +245,9 @@ vector<TaskResult<T>*> TaskScheduler<T>::runTasks(vector<Task<T>*> &tasks) {
 	}
 
 	// task distribution finished
+	for (int i = 0; i < taskNum; i++) {
+		tasks[i]->scheduled(taskOnIPVector[i]);
+	}
 
 	// run tasks those been distributed to this node
 	int runOnThisNodeTaskNum = 0;
@@ -202,6 +257,9 @@ vector<TaskResult<T>*> TaskScheduler<T>::runTasks(vector<Task<T>*> &tasks) {
 			runOnThisNodeTaskNum++;
 	}
 	vector<int> launchedTask = vector<int>(taskNum);
+	pthread_mutex_lock(&mutex_task_scheduler);
+	waitingTaskNum = runOnThisNodeTaskNum;
+	pthread_mutex_unlock(&mutex_task_scheduler);
 
 	while (!allTaskResultsReceived) { // waiting until all results received
 		if (lanuchedTaskNum == runOnThisNodeTaskNum) {
@@ -236,6 +294,24 @@ vector<TaskResult<T>*> TaskScheduler<T>::runTasks(vector<Task<T>*> &tasks) {
 					&& lanuchedTaskNum < runOnThisNodeTaskNum) {
 				for (int i = 0; i < taskNum; i++) {
 					if (taskOnIPVector[i] == selfIP && launchedTask[i] == 0) { // pick non started task
+						// a task waits for memory released by running tasks, unless none is running.
+						// both are read under the mutex guarding cond_task_memory: if none is running,
+						// none starts before the reservation, as only this thread launches tasks.
+						size_t memory = this->estimateTaskMemory(i);
+						pthread_mutex_lock(&mutex_task_scheduler);
+						long released = memoryReleasedNum;
+						bool noneRunning = runningThreadNum == 0;
+						pthread_mutex_unlock(&mutex_task_scheduler);
+						if (!XYZ_MEMORY_GOVERNOR.reserve(memory, noneRunning)) {
+							pthread_mutex_lock(&mutex_task_scheduler);
+							while (memoryReleasedNum == released && runningThreadNum > 0) {
+								pthread_cond_wait(&cond_task_memory, &mutex_task_scheduler);
+							}
+							pthread_mutex_unlock(&mutex_task_scheduler);
+							break;
+						}
+						taskMemory[i] = memory;
+
 						pthread_t thread;
 						struct xyz_task_scheduler_thread_data_<T> *data =
 								new xyz_task_scheduler_thread_data_<T>(this,
@@ -252,6 +328,9 @@ vector<TaskResult<T>*> TaskScheduler<T>::runTasks(vector<Task<T>*> &tasks) {
 						launchedTask[i] = 1;
 						lanuchedTaskNum++;
 						increaseRunningThreadNum();
+						pthread_mutex_lock(&mutex_task_scheduler);
+						waitingTaskNum--;
+						pthread_mutex_unlock(&mutex_task_scheduler);
 						break;
 					}
 				}
@@ -288,6 +367,11 @@ void TaskScheduler<T>::finishTask(int task, T &value) {
 				+ TASK_RESULT_DELIMITATION
 				+ this->tasks[task]->serialize(value);
 
+		// tasks may be deleted once all results are received, so memory is released before sending
+		if(XYZ_TASK_SCHEDULER_RUN_TASK_MODE == 1) {
+			this->releaseTaskMemory(task, msg.size());
+		}
+
 		usleep(rand()%500000); // delay sending result
 		this->sendMessage(this->master, this->listenPort, A_TASK_RESULT, msg);
 		if(XYZ_TASK_SCHEDULER_RUN_TASK_MODE == 1) {
@@ -371,13 +455,30 @@ void TaskScheduler<T>::handleMessage(
 				Logging::logInfo(
 						"TaskScheduler: master: sending out results...");
 
-				// send out to other nodes
-				string msg;
-				this->getTaskResultListString(this->jobID, msg);
-
+				// send out to other nodes in parallel, each of them is streamed the list as it is serialized.
+				// a task result is serialized once, by the first sender to reach it, and shared with the others
+				int senderNum = 0;
+				for (unsigned int i = 0; i < IPVector.size(); i++) {
+					if(IPVector[i] != selfIP) senderNum++;
+				}
+				resultStrings = vector<string>(tasks.size());
+				resultStringStates = vector<int>(tasks.size(), 0);
+				resultStringTakers = vector<int>(tasks.size(), senderNum);
+				vector<pthread_t> senders;
 				for (unsigned int i = 0; i < IPVector.size(); i++) {
 					if(IPVector[i] == selfIP) continue;
-					sendMessage(IPVector[i], listenPort, TASK_RESULT_LIST, msg);
+					pthread_t thread;
+					struct xyz_task_scheduler_send_data_<T> *data =
+							new xyz_task_scheduler_send_data_<T>(this, IPVector[i], listenPort, this->jobID);
+					if (pthread_create(&thread, NULL, xyz_task_scheduler_send_result_list_<T>,
+							(void *) data) != 0) {
+						xyz_task_scheduler_send_result_list_<T>(data); // send in this thread instead
+					} else {
+						senders.push_back(thread);
+					}
+				}
+				for (unsigned int i = 0; i < senders.size(); i++) {
+					pthread_join(senders[i], NULL);
 				}
 				taskResultListSent = true;
 
@@ -398,55 +499,13 @@ void TaskScheduler<T>::handleMessage(
 			Logging::logInfo("TaskScheduler: task result list received");
 
 			// save task results
-			// initialize taskResults
-			bool valid = true;
 			vector<string> results;
 			splitString(msg, results, TASK_RESULT_LIST_DELIMITATION);
-			if (results.size() == tasks.size()) {
-				for (unsigned int i = 0; i < tasks.size(); i++) {
-					vector<string> vs;
-					splitString(results[i], vs, TASK_RESULT_DELIMITATION);
-					if (vs.size() >= 2) {
-						int jobID = atoi(vs[0].c_str());
-						int taskID = atoi(vs[1].c_str());
-
-						if (jobID == this->jobID && (unsigned)taskID < tasks.size()
-								&& !resultReceived[taskID]) {
-							if (vs.size() >= 3) {
-								T value = tasks[taskID]->deserialize(vs[2]);
-								taskResults[i] =
-										new TaskResult<T>(tasks[taskID],
-												value);
-							} else {
-								string rs = "";
-								T value = tasks[taskID]->deserialize(rs);
-								taskResults[i] =
-										new TaskResult<T>(tasks[taskID],
-												value);
-							}
-							resultReceived[taskID] = true;
-							receivedTaskResultNum++;
-						} else {
-							valid = false;
-							break;
-						}
-					} else {
-						valid = false;
-						break;
-					}
-				}
-			} else {
-				valid = false;
-			}
-
-			if (valid) {
-				allTaskResultsReceived = true;
-				pthread_mutex_unlock(&mutex_all_tasks_received);
-
-			} else { // error
-				Logging::logError(
-						"TaskScheduler: task result list invalid");
+			bool valid = true;
+			for (unsigned int i = 0; i < results.size() && valid; i++) {
+				valid = this->receiveTaskResult(results[i]);
 			}
+			this->finishTaskResultList(results.size(), valid);
 		} else {
 			// master had all results
 		}
@@ -487,6 +546,73 @@ template<class T>
 void TaskScheduler<T>::decreaseRunningThreadNum() {
 	pthread_mutex_lock(&mutex_task_scheduler);
 	runningThreadNum--;
+	pthread_cond_broadcast(&cond_task_memory);
+	pthread_mutex_unlock(&mutex_task_scheduler);
+}
+
+/*
+ * to reserve idle threads of this node for helper threads of a running task, at most most.
+ * threads are idle if they neither run tasks nor are needed by tasks of this job not launched yet.
+ * reserved threads are counted as running, so no task is launched on them until released.
+ * tasks run by fork are not counted by threads, so none is reserved then.
+ */
+template<class T>
+int TaskScheduler<T>::reserveHelperThreads(int most) {
+	if (XYZ_TASK_SCHEDULER_RUN_TASK_MODE != 1) return 0;
+
+	pthread_mutex_lock(&mutex_task_scheduler);
+	int idle = threadCountVector[selfIPIndex] - runningThreadNum - waitingTaskNum;
+	int ret = most < idle ? most : idle;
+	if (ret < 0) ret = 0;
+	runningThreadNum += ret;
+	pthread_mutex_unlock(&mutex_task_scheduler);
+	return ret;
+}
+
+/*
+ * helper threads reserved by reserveHelperThreads have finished
+ */
+template<class T>
+void TaskScheduler<T>::releaseHelperThreads(int num) {
+	if (num <= 0) return;
+
+	pthread_mutex_lock(&mutex_task_scheduler);
+	runningThreadNum -= num;
+	pthread_cond_broadcast(&cond_task_memory);
+	pthread_mutex_unlock(&mutex_task_scheduler);
+}
+
+/*
+ * to estimate memory a task uses when running.
+ * tasks of a job are alike, so it is the most memory used by finished tasks of the job.
+ * before any finished, or if larger, the input of the task is expected to be held.
+ */
+template<class T>
+size_t TaskScheduler<T>::estimateTaskMemory(int task) {
+	size_t expected = tasks[task]->memoryExpected();
+	pthread_mutex_lock(&mutex_task_scheduler);
+	size_t memory = memoryPerTask;
+	pthread_mutex_unlock(&mutex_task_scheduler);
+	return expected > memory ? expected : memory;
+}
+
+/*
+ * to release memory reserved by a finished task, and learn how much it used.
+ * the serialized result is used if the task does not know its working set.
+ */
+template<class T>
+void TaskScheduler<T>::releaseTaskMemory(int task, size_t resultSize) {
+	size_t used = tasks[task]->memoryUsed();
+	if (used == 0) {
+		used = resultSize;
+	}
+	XYZ_MEMORY_GOVERNOR.release(taskMemory[task]);
+	pthread_mutex_lock(&mutex_task_scheduler);
+	if (used > memoryPerTask) {
+		memoryPerTask = used;
+	}
+	memoryReleasedNum++;
+	pthread_cond_broadcast(&cond_task_memory); // wake up the task waiting for memory
 	pthread_mutex_unlock(&mutex_task_scheduler);
 }
 
@@ -512,24 +638,164 @@ bool TaskScheduler<T>::getTaskResultString(int job, int task, string &result) {
 }
 
 /*
- * to get task result list as string
+ * to get a task result as string for a sender of the task result list, or skip it if result is NULL.
+ * the first sender serializes it, outside the lock, the others wait for it and copy it.
+ * the string is dropped once every sender has taken or skipped it,
+ * so only the results between the slowest and the fastest sender are kept.
+ */
+template<class T>
+void TaskScheduler<T>::takeTaskResultString(int task, string *result) {
+	pthread_mutex_lock(&mutex_result_strings);
+	if (result == NULL) {
+		if (--resultStringTakers[task] == 0) {
+			string().swap(resultStrings[task]);
+		}
+		pthread_mutex_unlock(&mutex_result_strings);
+		return;
+	}
+	while (resultStringStates[task] == 1) { // being serialized by another sender
+		pthread_cond_wait(&cond_result_strings, &mutex_result_strings);
+	}
+	if (resultStringStates[task] == 0) {
+		resultStringStates[task] = 1;
+		pthread_mutex_unlock(&mutex_result_strings);
+		string tr;
+		this->getTaskResultString(jobID, task, tr);
+		pthread_mutex_lock(&mutex_result_strings);
+		resultStrings[task].swap(tr);
+		resultStringStates[task] = 2;
+		pthread_cond_broadcast(&cond_result_strings);
+	}
+	if (--resultStringTakers[task] > 0) {
+		*result = resultStrings[task];
+	} else {
+		result->swap(resultStrings[task]); // the last sender, nothing is left to share
+	}
+	pthread_mutex_unlock(&mutex_result_strings);
+}
+
+/*
+ * to write task result list, one task result after another
  */
 template<class T>
-bool TaskScheduler<T>::getTaskResultListString(int job, string &result) {
+bool TaskScheduler<T>::writeTaskResultList(int job, ChunkedWriter &writer) {
 	if (job != this->jobID) return false;
 	if (!this->allTaskResultsReceived) return false;
 
-	result = "";
 	for (unsigned int i=0; i<this->tasks.size(); i++) {
+		if (writer.failed()) { // the node is lost, the rest is not serialized for it
+			this->takeTaskResultString(i, NULL);
+			continue;
+		}
 		string tr;
-		this->getTaskResultString(job, i, tr);
-		result += tr;
+		this->takeTaskResultString(i, &tr);
+		writer.write(tr);
 		if (i != this->tasks.size()-1) {
-			result += TASK_RESULT_LIST_DELIMITATION;
+			writer.write(TASK_RESULT_LIST_DELIMITATION);
 		}
 	}
 	return true;
 }
 
+/*
+ * to skip the task result list, for a node it cannot be sent to
+ */
+template<class T>
+void TaskScheduler<T>::skipTaskResultList(int job) {
+	if (job != this->jobID) return;
+
+	for (unsigned int i=0; i<this->tasks.size(); i++) {
+		this->takeTaskResultString(i, NULL);
+	}
+}
+
+/*
+ * to create a decoder of task result list from master.
+ * return NULL for other messages, and on master, which has all results.
+ */
+template<class T>
+MessageDecoder * TaskScheduler<T>::createDecoder(int localListenPort, string fromHost, int msgType) {
+	if (msgType != TASK_RESULT_LIST) return NULL;
+
+	pthread_mutex_lock(&mutex_handle_message_ready);
+	pthread_mutex_unlock(&mutex_handle_message_ready);
+
+	if (isMaster == 1) return NULL;
+	Logging::logInfo("TaskScheduler: task result list receiving");
+	return new TaskResultListDecoder<T>(this);
+}
+
+/*
+ * to save a task result of the task result list from master.
+ * return false if it is not a result of this job, or received before.
+ */
+template<class T>
+bool TaskScheduler<T>::receiveTaskResult(string &result) {
+	vector<string> vs;
+	splitString(result, vs, TASK_RESULT_DELIMITATION);
+	if (vs.size() < 2) return false;
+
+	int jobID = atoi(vs[0].c_str());
+	int taskID = atoi(vs[1].c_str());
+	if (jobID != this->jobID || (unsigned)taskID >= tasks.size()
+			|| resultReceived[taskID]) {
+		return false;
+	}
+
+	if (vs.size() >= 3) {
+		T value = tasks[taskID]->deserialize(vs[2]);
+		taskResults[taskID] = new TaskResult<T>(tasks[taskID], value);
+	} else {
+		string rs = "";
+		T value = tasks[taskID]->deserialize(rs);
+		taskResults[taskID] = new TaskResult<T>(tasks[taskID], value);
+	}
+	resultReceived[taskID] = true;
+	receivedTaskResultNum++;
+	return true;
+}
+
+/*
+ * all task results of the list from master are saved
+ */
+template<class T>
+void TaskScheduler<T>::finishTaskResultList(int count, bool valid) {
+	if (valid && (unsigned)count == tasks.size()) {
+		allTaskResultsReceived = true;
+		pthread_mutex_unlock(&mutex_all_tasks_received);
+	} else { // error
+		Logging::logError(
+				"TaskScheduler: task result list invalid");
+	}
+}
+
+/*
+ * constructor of TaskResultListDecoder
+ */
+template<class T>
+TaskResultListDecoder<T>::TaskResultListDecoder(TaskScheduler<T> *ts)
+: RecordDecoder(TASK_RESULT_LIST_DELIMITATION), taskScheduler(ts), count(0), valid(true) {
+}
+
+/*
+ * to save a task result as soon as it is received
+ */
+template<class T>
+void TaskResultListDecoder<T>::record(string &s) {
+	if (valid) {
+		valid = taskScheduler->receiveTaskResult(s);
+	}
+	count++;
+}
+
+/*
+ * to check all the task results are received
+ */
+template<class T>
+void TaskResultListDecoder<T>::finish() {
+	RecordDecoder::finish();
+	taskScheduler->finishTaskResultList(count, valid);
+}
+
 #endif /* TASKSCHEDULER_HPP_ */
 
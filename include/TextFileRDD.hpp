@@ -51,6 +51,22 @@ TextFileRDD::TextFileRDD(SunwayMRContext *c, vector<FileSource> &files, int numS
 	}
 
 	RDD<TextFileBlock>::partitions = partitions;
+
+	// files served to other nodes stay cached across jobs
+	for (unsigned int i = 0; i < files.size(); i++) {
+		filePaths.push_back(files[i].path);
+		RDD<TextFileBlock>::context->retainFileCache(files[i].path);
+	}
+}
+
+/*
+ * destructor.
+ * files read by this RDD are released from cache.
+ */
+TextFileRDD::~TextFileRDD() {
+	for (unsigned int i = 0; i < filePaths.size(); i++) {
+		RDD<TextFileBlock>::context->releaseFileCache(filePaths[i]);
+	}
 }
 
 /*
@@ -77,6 +93,24 @@ IteratorSeq<TextFileBlock> * TextFileRDD::iteratorSeq(Partition *p) {
 	return pap->iteratorSeq();
 }
 
+/*
+ * to get bytes of file blocks in a partition.
+ * a block of lines is taken to have the average line length of its file.
+ */
+size_t TextFileRDD::inputBytes(Partition *p) {
+	TextFilePartition *pap = dynamic_cast<TextFilePartition * >(p);
+	size_t bytes = 0;
+	for(size_t i = 0; i < pap->values->size(); i++) {
+		TextFileBlock block = pap->values->at(i);
+		if(block.format == FILE_SOURCE_FORMAT_BYTE) {
+			bytes += block.length;
+		} else if(block.file.lines > 0) {
+			bytes += (size_t)((double)block.length * block.file.bytes / block.file.lines);
+		}
+	}
+	return bytes;
+}
+
 
 string master_ip;
 int scheduler_listen_port;
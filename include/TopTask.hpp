@@ -0,0 +1,86 @@
+/*
+ * TopTask.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_TOPTASK_HPP_
+#define INCLUDE_TOPTASK_HPP_
+
+#include "TopTask.h"
+
+#include <algorithm>
+
+#include "IteratorSeq.hpp"
+#include "RDDTask.hpp"
+#include "Utils.hpp"
+#include "StringConversion.hpp"
+
+/*
+ * constructor
+ */
+template <class T>
+TopTask<T>::TopTask(RDD<T> *r, Partition *p, long k, bool (*less)(T&, T&), bool largest)
+:RDDTask< T, vector<T> >::RDDTask(r, p), k(k), order(less, largest)
+{
+}
+
+/*
+ * to keep the first k values in order.
+ * the heap top is the last value kept, replaced by any value coming before it.
+ */
+template <class T>
+vector<T> TopTask<T>::run() {
+	IteratorSeq<T> *seq = RDDTask< T, vector<T> >::rdd->getOrCompute(RDDTask< T, vector<T> >::partition);
+	vector<T> heap;
+	if (k <= 0) return heap;
+
+	size_t n = seq->size();
+	heap.reserve((size_t)k < n ? k : n);
+	for (size_t i = 0; i < n; i++) {
+		T t = seq->at(i);
+		if (heap.size() < (size_t)k) {
+			heap.push_back(t);
+			push_heap(heap.begin(), heap.end(), order);
+		} else if (order(t, heap.front())) {
+			pop_heap(heap.begin(), heap.end(), order);
+			heap.back() = t;
+			push_heap(heap.begin(), heap.end(), order);
+		}
+	}
+
+	sort_heap(heap.begin(), heap.end(), order);
+	return heap;
+}
+
+/*
+ * to serialize the task result
+ */
+template <class T>
+string TopTask<T>::serialize(vector<T> &t) {
+	string ret = "";
+	for (unsigned int i=0; i<t.size(); i++) {
+		ret += to_string(t[i]);
+		if (i != t.size()-1) ret += TOP_TASK_DELIMITATION;
+	}
+	return ret;
+}
+
+/*
+ * to deserialize a string to task result
+ */
+template <class T>
+vector<T> TopTask<T>::deserialize(string &s) {
+	vector<T> elems;
+	vector<string> vs;
+	splitString(s, vs, TOP_TASK_DELIMITATION);
+
+	for(unsigned int i=0; i<vs.size(); i++) {
+		T t;
+		from_string(t, vs[i]);
+		elems.push_back(t);
+	}
+	return elems;
+}
+
+#endif /* INCLUDE_TOPTASK_HPP_ */
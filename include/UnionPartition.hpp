@@ -30,7 +30,7 @@ UnionPartition<T>::UnionPartition(long rddID, int partitionID, RDD<T> *rdd, Part
  */
 template <class T>
 IteratorSeq<T> * UnionPartition<T>::iteratorSeq() {
-	return rdd->iteratorSeq(partition);
+	return rdd->getOrCompute(partition);
 }
 
 /*
@@ -38,7 +38,7 @@ IteratorSeq<T> * UnionPartition<T>::iteratorSeq() {
  */
 template <class T>
 vector<string> UnionPartition<T>::preferredLocations() {
-	return rdd->preferredLocations(partition);
+	return rdd->getPreferredLocations(partition);
 }
 
 #endif /* INCLUDE_UNIONPARTITION_HPP_ */
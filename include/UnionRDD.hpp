@@ -57,6 +57,16 @@ vector<string> UnionRDD<T>::preferredLocations(Partition *p) {
 	return up->preferredLocations();
 }
 
+/*
+ * a task on the partition computes the wrapped partition of previous RDDs as well.
+ */
+template <class T>
+void UnionRDD<T>::partitionScheduled(Partition *p, string host) {
+	RDD<T>::partitionScheduled(p, host);
+	UnionPartition<T> *up = dynamic_cast<UnionPartition<T> * >(p);
+	up->rdd->partitionScheduled(up->partition, host);
+}
+
 /*
  * to get data of a partition
  */
@@ -26,6 +26,8 @@
 #include <sys/types.h>
 #include <dirent.h>
 #include <time.h>
+#include <fcntl.h>
+#include <errno.h>
 using namespace std;
 
 int splitString(const std::string& str, std::vector<std::string>& ret, const std::string& delim)
@@ -325,6 +327,28 @@ bool writeFile(string dir, string fileName, string content) {
 	}
 }
 
+/*
+ * write data to a new file by system calls only, without streams,
+ * so it can be called in forked task processes.
+ */
+bool writeRawFile(string path, const char *data, size_t size) {
+	int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	while (size > 0) {
+		ssize_t n = write(fd, data, size);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			close(fd);
+			return false;
+		}
+		data += n;
+		size -= n;
+	}
+	return close(fd) == 0;
+}
+
 bool readFile(string path, string &content) {
 	std::ifstream file(path.c_str(), std::ifstream::in);
 	if (file.is_open()) {
@@ -60,6 +60,20 @@ template <class T> void VectorIteratorSeq<T>::reserve(size_t size) {
 	this->v.reserve(size);
 }
 
+/*
+ * to sort elements by a comparing function
+ */
+template <class T> void VectorIteratorSeq<T>::sort(bool (*cmp)(const T&, const T&)) {
+	std::sort(this->v.begin(), this->v.end(), cmp);
+}
+
+/*
+ * exchange elements with a vector, without copying
+ */
+template <class T> void VectorIteratorSeq<T>::swap(vector<T> &other) {
+	this->v.swap(other);
+}
+
 /*
  * to get the type of IteratorSeq.
  * return 1.
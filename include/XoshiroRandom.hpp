@@ -0,0 +1,101 @@
+/*
+ * XoshiroRandom.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_XOSHIRORANDOM_HPP_
+#define INCLUDE_XOSHIRORANDOM_HPP_
+
+#include "XoshiroRandom.h"
+
+#include <math.h>
+
+/*
+ * finalizer of splitmix64, mixing all bits of x
+ */
+uint64_t xyz_xoshiro_random_mix_f(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+/*
+ * constructor
+ */
+XoshiroRandom::XoshiroRandom(uint64_t seed) {
+	setSeed(seed);
+}
+
+/*
+ * constructor, of an independent stream of the seed
+ */
+XoshiroRandom::XoshiroRandom(uint64_t seed, long stream) {
+	setSeed(xyz_xoshiro_random_mix_f(seed) ^ xyz_xoshiro_random_mix_f(
+			(uint64_t) stream + 0x9E3779B97F4A7C15ULL));
+}
+
+/*
+ * to fill the state by splitmix64, so it is never all zero
+ */
+void XoshiroRandom::setSeed(uint64_t seed) {
+	for (int i = 0; i < 4; i++) {
+		seed += 0x9E3779B97F4A7C15ULL;
+		s[i] = xyz_xoshiro_random_mix_f(seed);
+	}
+}
+
+/*
+ * next 64 random bits
+ */
+uint64_t XoshiroRandom::next() {
+	uint64_t x = s[1] * 5;
+	uint64_t ret = ((x << 7) | (x >> 57)) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 45) | (s[3] >> 19);
+	return ret;
+}
+
+/*
+ * next double in [0, 1), of the high 53 bits
+ */
+double XoshiroRandom::nextDouble() {
+	return (next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * next long in [0, n), 0 if n <= 0
+ */
+long XoshiroRandom::nextLong(long n) {
+	if (n <= 0) return 0;
+	return (long) (nextDouble() * n);
+}
+
+/*
+ * next number of a Poisson distribution.
+ * by multiplying uniform numbers, for mean of at most 16 at a time,
+ * as a sum of Poisson numbers is a Poisson number of the sum of means.
+ */
+long XoshiroRandom::nextPoisson(double mean) {
+	long ret = 0;
+	while (mean > 0) {
+		double m = mean > 16 ? 16 : mean;
+		mean -= m;
+
+		double limit = exp(-m);
+		double product = nextDouble();
+		while (product >= limit) {
+			ret++;
+			product *= nextDouble();
+		}
+	}
+	return ret;
+}
+
+#endif /* INCLUDE_XOSHIRORANDOM_HPP_ */
@@ -0,0 +1,144 @@
+/*
+ * ZippedJoinRDD.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_ZIPPEDJOINRDD_HPP_
+#define INCLUDE_ZIPPEDJOINRDD_HPP_
+
+#include "ZippedJoinRDD.h"
+
+#include <tr1/unordered_map>
+
+#include "IteratorSeq.hpp"
+#include "VectorIteratorSeq.hpp"
+#include "Partition.hpp"
+#include "ZippedPartition.hpp"
+#include "RDD.hpp"
+#include "Pair.hpp"
+#include "HashDivider.hpp"
+using namespace std;
+using std::tr1::unordered_map;
+
+/*
+ * constructor.
+ * both RDDs must have the same number of partitions.
+ */
+template <class K, class V, class W>
+ZippedJoinRDD<K, V, W>::ZippedJoinRDD(RDD< Pair<K, V> > *left, RDD< Pair<K, W> > *right)
+:RDD< Pair< K, Pair<V, W> > >::RDD(left->context), leftRDD(left), rightRDD(right)
+{
+	vector<Partition*> lps = leftRDD->getPartitions();
+	vector<Partition*> rps = rightRDD->getPartitions();
+	vector<Partition*> partitions;
+	for (unsigned int i = 0; i < lps.size() && i < rps.size(); i++) {
+		partitions.push_back(new ZippedPartition(this->rddID, i, lps[i], rps[i]));
+	}
+	this->partitions = partitions;
+}
+
+/*
+ * destructor, deleting the previous RDDs if they are not sticky
+ */
+template <class K, class V, class W>
+ZippedJoinRDD<K, V, W>::~ZippedJoinRDD()
+{
+	if(!this->leftRDD->isSticky()) {
+		delete this->leftRDD;
+	}
+	if(!this->rightRDD->isSticky()) {
+		delete this->rightRDD;
+	}
+}
+
+/*
+ * to shuffle.
+ * just do shuffle in both previous RDDs.
+ */
+template <class K, class V, class W>
+void ZippedJoinRDD<K, V, W>::shuffle()
+{
+	leftRDD->shuffle();
+	rightRDD->shuffle();
+}
+
+/*
+ * keys are kept, so is the partitioner of previous RDDs
+ */
+template <class K, class V, class W>
+HashDivider * ZippedJoinRDD<K, V, W>::getPartitioner()
+{
+	return leftRDD->getPartitioner();
+}
+
+/*
+ * to get partitions of this RDD
+ */
+template <class K, class V, class W>
+vector<Partition *> ZippedJoinRDD<K, V, W>::getPartitions()
+{
+	return this->partitions;
+}
+
+/*
+ * to get preferred locations of a partition.
+ * as to ZippedJoinRDD, the same as the left partition.
+ */
+template <class K, class V, class W>
+vector<string> ZippedJoinRDD<K, V, W>::preferredLocations(Partition *p)
+{
+	ZippedPartition *zp = dynamic_cast<ZippedPartition *>(p);
+	return leftRDD->getPreferredLocations(zp->left);
+}
+
+/*
+ * a task on the partition computes both zipped partitions of previous RDDs as well.
+ */
+template <class K, class V, class W>
+void ZippedJoinRDD<K, V, W>::partitionScheduled(Partition *p, string host)
+{
+	RDD< Pair<K, Pair<V, W> > >::partitionScheduled(p, host);
+	ZippedPartition *zp = dynamic_cast<ZippedPartition *>(p);
+	leftRDD->partitionScheduled(zp->left, host);
+	rightRDD->partitionScheduled(zp->right, host);
+}
+
+/*
+ * to get data of a partition.
+ * values of the right partition are hashed by key,
+ * then each pair of the left partition is joined with values of the same key.
+ */
+template <class K, class V, class W>
+IteratorSeq< Pair< K, Pair<V, W> > > * ZippedJoinRDD<K, V, W>::iteratorSeq(Partition *p)
+{
+	ZippedPartition *zp = dynamic_cast<ZippedPartition *>(p);
+
+	unordered_map< K, vector<W> > table;
+	IteratorSeq< Pair<K, W> > *rseq = rightRDD->getOrCompute(zp->right);
+	size_t rn = rseq->size();
+	for (size_t i = 0; i < rn; i++) {
+		Pair<K, W> pr = rseq->at(i);
+		table[pr.v1].push_back(pr.v2);
+	}
+
+	IteratorSeq< Pair<K, V> > *lseq = leftRDD->getOrCompute(zp->left);
+	VectorIteratorSeq< Pair< K, Pair<V, W> > > *ret = new VectorIteratorSeq< Pair< K, Pair<V, W> > >();
+	typename unordered_map< K, vector<W> >::iterator it;
+	size_t ln = lseq->size();
+	for (size_t i = 0; i < ln; i++) {
+		Pair<K, V> pl = lseq->at(i);
+		it = table.find(pl.v1);
+		if (it == table.end()) continue;
+		for (size_t j = 0; j < it->second.size(); j++) {
+			Pair<V, W> right(pl.v2, it->second[j]);
+			ret->push_back(Pair< K, Pair<V, W> >(pl.v1, right));
+		}
+	}
+
+	this->addIteratorSeq(ret); // for garbage collection
+	return ret;
+}
+
+
+#endif /* INCLUDE_ZIPPEDJOINRDD_HPP_ */
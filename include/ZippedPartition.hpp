@@ -0,0 +1,20 @@
+/*
+ * ZippedPartition.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INCLUDE_ZIPPEDPARTITION_HPP_
+#define INCLUDE_ZIPPEDPARTITION_HPP_
+
+#include "ZippedPartition.h"
+#include "Partition.hpp"
+
+/*
+ * constructor
+ */
+ZippedPartition::ZippedPartition(long rddID, int partitionID, Partition *left, Partition *right)
+:rddID(rddID), partitionID(partitionID), left(left), right(right) {
+}
+
+#endif /* INCLUDE_ZIPPEDPARTITION_HPP_ */
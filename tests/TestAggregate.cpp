@@ -0,0 +1,81 @@
+/*
+ * TestAggregate.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+
+/*
+ * (sum, count) of values
+ */
+Pair<long, long> seq_op_f(Pair<long, long> &u, long &i) {
+	long sum = u.v1 + i;
+	long count = u.v2 + 1;
+	return Pair<long, long>(sum, count);
+}
+
+Pair<long, long> comb_op_f(Pair<long, long> &a, Pair<long, long> &b) {
+	long sum = a.v1 + b.v1;
+	long count = a.v2 + b.v2;
+	return Pair<long, long>(sum, count);
+}
+
+long add_f(long &a, long &b) {
+	return a + b;
+}
+
+long max_f(long &a, long &b) {
+	return a > b ? a : b;
+}
+
+bool none_f(long &i) {
+	return false;
+}
+
+bool check(Pair<long, long> result, long sum, long count, string name) {
+	bool ok = result.v1 == sum && result.v2 == count;
+	cout << name << ": sum " << result.v1 << ", count " << result.v2 << ", "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(long result, long expected, string name) {
+	bool ok = result == expected;
+	cout << name << ": " << result << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestAggregate <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestAggregate", argc, argv);
+
+	long zl = 0;
+	Pair<long, long> zero(zl, zl);
+	long sum = NUM_VALUES * (NUM_VALUES + 1) / 2;
+
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->aggregate(zero, seq_op_f, comb_op_f),
+			sum, NUM_VALUES, "aggregate");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 64)->treeAggregate(zero, seq_op_f, comb_op_f, 3),
+			sum, NUM_VALUES, "treeAggregate of depth 3") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 7)->treeAggregate(zero, seq_op_f, comb_op_f),
+			sum, NUM_VALUES, "treeAggregate of few partitions") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 10)->filter(none_f)->treeAggregate(zero, seq_op_f, comb_op_f),
+			0, 0, "treeAggregate of none") && ok;
+
+	ok = check(sc.parallelize(1L, NUM_VALUES, 10)->fold(0L, add_f), sum, "fold by add") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 10)->fold(0L, max_f), NUM_VALUES, "fold by max") && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+/*
+ * TestBroadcastJoin.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_LARGE = 20000;
+const long NUM_SMALL = 100;
+
+/*
+ * keys 0 to 49, each repeated
+ */
+Pair<long, long> large_f(long &i) {
+	long k = i % 50;
+	return Pair<long, long>(k, i);
+}
+
+/*
+ * keys 40 to 59, each repeated, keys 0 to 39 are only in the large RDD, 50 to 59 only here
+ */
+Pair<long, long> small_f(long &i) {
+	long k = 40 + i % 20;
+	long v = -i;
+	return Pair<long, long>(k, v);
+}
+
+/*
+ * to compare joined pairs in any order
+ */
+bool check(vector< Pair< long, Pair<long, long> > > result,
+		vector< Pair< long, Pair<long, long> > > &expected, string name) {
+	sort(result.begin(), result.end());
+	bool ok = result == expected;
+	cout << name << ": " << result.size() << " pairs, " << expected.size() << " expected, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestBroadcastJoin <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestBroadcastJoin", argc, argv);
+
+	PairRDD<long, long, long> *large = sc.parallelize(1L, NUM_LARGE, 8)->mapToPair(large_f);
+	PairRDD<long, long, long> *small = sc.parallelize(1L, NUM_SMALL, 3)->mapToPair(small_f);
+	large->setSticky(true);
+	small->setSticky(true);
+
+	// pairs of every value of a key on both sides
+	vector< Pair< long, Pair<long, long> > > expected, reversed;
+	for (long i = 1; i <= NUM_LARGE; i++) {
+		for (long j = 1; j <= NUM_SMALL; j++) {
+			Pair<long, long> l = large_f(i), r = small_f(j);
+			if (l.v1 != r.v1) continue;
+			Pair<long, long> lr(l.v2, r.v2), rl(r.v2, l.v2);
+			expected.push_back(Pair< long, Pair<long, long> >(l.v1, lr));
+			reversed.push_back(Pair< long, Pair<long, long> >(l.v1, rl));
+		}
+	}
+	sort(expected.begin(), expected.end());
+	sort(reversed.begin(), reversed.end());
+
+	bool ok = check(large->join(small)->collect(), expected, "join");
+	ok = check(large->broadcastJoin(small)->collect(), expected, "broadcastJoin") && ok;
+	ok = check(small->join(large)->collect(), reversed, "join of the small RDD") && ok;
+	ok = check(small->broadcastJoin(large)->collect(), reversed, "broadcastJoin of the small RDD") && ok;
+
+	delete large;
+	delete small;
+
+	return ok ? 0 : 1;
+}
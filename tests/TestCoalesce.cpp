@@ -0,0 +1,140 @@
+/*
+ * TestCoalesce.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+const long NUM_KEYS = 400000; // distinct keys of large shuffles
+
+long add_f(long &a, long &b) {
+	return a + b;
+}
+
+/*
+ * to keep all of the first values, and few of the others,
+ * so partitions of the input are uneven
+ */
+bool skew_f(long &i) {
+	return i < NUM_VALUES / 5 || i % 100 == 0;
+}
+
+void partition_size_f(IteratorSeq<long> &it, vector<long> &ret) {
+	ret.push_back(it.size());
+}
+
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = i % 1000;
+	long one = 1;
+	return Pair<long, long>(k, one);
+}
+
+Pair<long, long> reduce_f(Pair<long, long> &a, Pair<long, long> &b) {
+	long sum = a.v2 + b.v2;
+	return Pair<long, long>(a.v1, sum);
+}
+
+long value_f(Pair<long, long> &p) {
+	return p.v2;
+}
+
+Pair<long, long> distinct_f(long &i) {
+	long one = 1;
+	return Pair<long, long>(i, one);
+}
+
+long joined_value_f(Pair< long, Pair<long, long> > &p) {
+	return p.v2.v1 + p.v2.v2;
+}
+
+/*
+ * to check sizes of partitions: their number, total and largest difference
+ */
+bool check(vector<long> sizes, size_t partitions, long total, long difference, string name) {
+	long sum = 0, least = total, most = 0;
+	for (size_t i = 0; i < sizes.size(); i++) {
+		sum += sizes[i];
+		if (sizes[i] < least) least = sizes[i];
+		if (sizes[i] > most) most = sizes[i];
+	}
+	bool ok = sizes.size() == partitions && sum == total && most - least <= difference;
+	cout << name << ": " << sum << " values in " << sizes.size() << " partitions of "
+			<< least << " to " << most << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(long result, long expected, string name) {
+	bool ok = result == expected;
+	cout << name << ": " << result << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestCoalesce <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestCoalesce", argc, argv);
+
+	long sum = NUM_VALUES * (NUM_VALUES + 1) / 2;
+	long skewed = 0, skewedSum = 0;
+	for (long i = 1; i <= NUM_VALUES; i++) {
+		if (skew_f(i)) {
+			skewed++;
+			skewedSum += i;
+		}
+	}
+
+	// coalesce
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->coalesce(3)->mapPartitions(partition_size_f)->collect(),
+			3, NUM_VALUES, NUM_VALUES, "coalesce");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->coalesce(3)->reduce(add_f), sum, "coalesce, sum") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 4)->coalesce(10)->getPartitions().size(), 4,
+			"coalesce to more partitions") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 8)->mapToPair(map_to_pair_f)->reduceByKey(reduce_f, 12)
+			->coalesce(4)->map(value_f)->reduce(add_f), NUM_VALUES, "coalesce of a shuffle") && ok;
+
+	// repartition, even partitions from uneven ones.
+	// values of each partition are sent in round robin, so sizes differ by input partitions at most.
+	RDD<long> *repartitioned = sc.parallelize(1L, NUM_VALUES, 5)->filter(skew_f)->repartition(7);
+	repartitioned->setSticky(true);
+	ok = check(repartitioned->mapPartitions(partition_size_f)->collect(),
+			7, skewed, 5, "repartition") && ok;
+	ok = check(repartitioned->reduce(add_f), skewedSum, "repartition, sum") && ok;
+	ok = check(repartitioned->reduce(add_f), skewedSum, "repartition, sum again") && ok;
+	delete repartitioned;
+
+	// one large partition, merged by helper threads on idle threads
+	ok = check(sc.parallelize(1L, NUM_KEYS, 8)->mapToPair(distinct_f)->reduceByKey(reduce_f, 1)
+			->map(value_f)->reduce(add_f), NUM_KEYS, "shuffle into one partition") && ok;
+
+	// adaptive shuffle, small partitions are coalesced and large ones split towards the target size
+	XYZ_SHUFFLE_ADAPTIVE_MODE = 1;
+	XYZ_SHUFFLE_ADAPTIVE_TARGET_BYTES = 256L << 10;
+	XYZ_SHUFFLE_ADAPTIVE_MIN_BYTES = 64L << 10;
+	int defaultPartitions = sc.getTotalThreads() * XYZ_SHUFFLE_ADAPTIVE_PARTITION_FACTOR;
+	PairRDD<long, long, Pair<long, long> > *small = sc.parallelize(1L, NUM_VALUES, 8)
+			->mapToPair(map_to_pair_f)->reduceByKey(reduce_f);
+	ok = check(small->map(value_f)->reduce(add_f), NUM_VALUES, "adaptive shuffle, small") && ok;
+	ok = check((long)small->getPartitions().size() < defaultPartitions, 1, "adaptive shuffle, coalesced") && ok;
+	ok = check(sc.parallelize(1L, NUM_KEYS, 8)->mapToPair(distinct_f)->reduceByKey(reduce_f)
+			->map(value_f)->reduce(add_f), NUM_KEYS, "adaptive shuffle, large") && ok;
+
+	PairRDD<long, long, long> *left = sc.parallelize(1L, NUM_KEYS, 8)->mapToPair(distinct_f);
+	PairRDD<long, long, long> *right = sc.parallelize(1L, NUM_KEYS, 8)->mapToPair(distinct_f);
+	PairRDD< long, Pair<long, long>, Pair< long, Pair<long, long> > > *joined = left->join(right);
+	ok = check(joined->map(joined_value_f)->reduce(add_f), 2 * NUM_KEYS, "adaptive join, large") && ok;
+	ok = check((long)joined->getPartitions().size() > defaultPartitions, 1, "adaptive join, split") && ok;
+
+	return ok ? 0 : 1;
+}
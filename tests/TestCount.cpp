@@ -0,0 +1,79 @@
+/*
+ * TestCount.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <map>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 1003;
+const long NUM_KEYS = 5;
+
+long mod_7_f(long &i) {
+	return i % 7;
+}
+
+bool even_f(long &i) {
+	return i % 2 == 0;
+}
+
+bool none_f(long &i) {
+	return false;
+}
+
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = i % NUM_KEYS;
+	return Pair<long, long>(k, i);
+}
+
+/*
+ * to compare counts of an action with counts computed here
+ */
+bool check(std::map<long, long> &counts, std::map<long, long> &expected, string name) {
+	bool ok = counts == expected;
+	cout << name << ": " << counts.size() << " keys, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(long count, long expected, string name) {
+	bool ok = count == expected;
+	cout << name << ": " << count << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestCount <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestCount", argc, argv);
+
+	std::map<long, long> values, keys;
+	long evens = 0;
+	for (long i = 1; i <= NUM_VALUES; i++) {
+		values[i % 7]++;
+		keys[i % NUM_KEYS]++;
+		if (i % 7 % 2 == 0) evens++;
+	}
+
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->count(), NUM_VALUES, "count");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 10)->map(mod_7_f)->filter(even_f)->count(),
+			evens, "count of filtered") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 10)->filter(none_f)->count(), 0, "count of none") && ok;
+
+	std::map<long, long> cv = sc.parallelize(1L, NUM_VALUES, 10)->map(mod_7_f)->countByValue();
+	ok = check(cv, values, "countByValue") && ok;
+
+	std::map<long, long> ck = sc.parallelize(1L, NUM_VALUES, 10)->mapToPair(map_to_pair_f)->countByKey();
+	ok = check(ck, keys, "countByKey") && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+/*
+ * TestGroupByKey.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 20000;
+const long NUM_KEYS = 37;
+
+/*
+ * every key is in every partition, values repeat within a group
+ */
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = i % NUM_KEYS;
+	long v = i % 100;
+	return Pair<long, long>(k, v);
+}
+
+/*
+ * to compare groups with groups computed here, values of a group in any order
+ */
+bool check(vector< Pair<long, VectorIteratorSeq<long> > > groups,
+		std::map<long, vector<long> > &expected, string name) {
+	std::map<long, vector<long> > result;
+	bool ok = true;
+	long values = 0;
+	for (size_t i = 0; i < groups.size(); i++) {
+		if (result.find(groups[i].v1) != result.end()) ok = false; // a key in two groups
+		vector<long> &group = result[groups[i].v1];
+		group = groups[i].v2.getVector();
+		sort(group.begin(), group.end());
+		values += group.size();
+	}
+	ok = ok && result == expected;
+	cout << name << ": " << result.size() << " groups of " << values << " values, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestGroupByKey <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestGroupByKey", argc, argv);
+
+	std::map<long, vector<long> > expected;
+	for (long i = 1; i <= NUM_VALUES; i++) {
+		Pair<long, long> p = map_to_pair_f(i);
+		expected[p.v1].push_back(p.v2);
+	}
+	for (std::map<long, vector<long> >::iterator it = expected.begin(); it != expected.end(); ++it) {
+		sort(it->second.begin(), it->second.end());
+	}
+
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 8)->mapToPair(map_to_pair_f)->groupByKey(5)->collect(),
+			expected, "groupByKey");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 8)->mapToPair(map_to_pair_f)->groupByKey(1)->collect(),
+			expected, "groupByKey to one partition") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 3)->mapToPair(map_to_pair_f)->groupByKey(64)->collect(),
+			expected, "groupByKey to more partitions than keys") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 8)->mapToPair(map_to_pair_f)->groupByKey()->collect(),
+			expected, "groupByKey by default partitions") && ok;
+
+	return ok ? 0 : 1;
+}
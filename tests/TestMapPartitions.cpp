@@ -0,0 +1,128 @@
+/*
+ * TestMapPartitions.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+
+bool odd_f(long &i) {
+	return i % 2 == 1;
+}
+
+long add_f(long &a, long &b) {
+	return a + b;
+}
+
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = i % 1000;
+	return Pair<long, long>(k, i);
+}
+
+Pair<long, long> reduce_f(Pair<long, long> &a, Pair<long, long> &b) {
+	long sum = a.v2 + b.v2;
+	return Pair<long, long>(a.v1, sum);
+}
+
+void partition_size_f(IteratorSeq<long> &it, vector<long> &ret) {
+	ret.push_back(it.size());
+}
+
+void partition_sum_f(IteratorSeq<long> &it, vector<long> &ret) {
+	long sum = 0;
+	for (size_t i = 0; i < it.size(); i++) {
+		sum += it.at(i);
+	}
+	ret.push_back(sum);
+}
+
+/*
+ * the index of the partition, once for each value of it
+ */
+void partition_index_f(int index, IteratorSeq<long> &it, vector<long> &ret) {
+	ret.resize(it.size(), index);
+}
+
+template <class T>
+void partition_index_size_f(int index, IteratorSeq<T> &it, vector< Pair<long, long> > &ret) {
+	long i = index, size = it.size();
+	ret.push_back(Pair<long, long>(i, size));
+}
+
+template <class T>
+void pair_partition_size_f(IteratorSeq<T> &it, vector<long> &ret) {
+	ret.push_back(it.size());
+}
+
+/*
+ * to check indices against sizes of the partitions in order:
+ * partition i has sizes[i] values, each of which is given index i
+ */
+bool check(vector<long> indices, vector<long> sizes, string name) {
+	vector<long> expected;
+	for (size_t i = 0; i < sizes.size(); i++) {
+		expected.resize(expected.size() + sizes[i], i);
+	}
+	bool ok = indices == expected;
+	cout << name << ": " << indices.size() << " values in " << sizes.size() << " partitions, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * to check (index, size) of each partition, in order of the partitions
+ */
+bool check(vector< Pair<long, long> > result, vector<long> sizes, string name) {
+	bool ok = result.size() == sizes.size();
+	for (size_t i = 0; ok && i < result.size(); i++) {
+		ok = result[i].v1 == (long)i && result[i].v2 == sizes[i];
+	}
+	cout << name << ": " << result.size() << " partitions, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(long result, long expected, string name) {
+	bool ok = result == expected;
+	cout << name << ": " << result << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestMapPartitions <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestMapPartitions", argc, argv);
+
+	long sum = NUM_VALUES * (NUM_VALUES + 1) / 2;
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->mapPartitions(partition_sum_f)->reduce(add_f),
+			sum, "mapPartitions, sums of partitions");
+
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->mapPartitionsWithIndex(partition_index_f)->collect(),
+			sc.parallelize(1L, NUM_VALUES, 16)->mapPartitions(partition_size_f)->collect(),
+			"mapPartitionsWithIndex") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 7)->filter(odd_f)->mapPartitionsWithIndex(partition_index_f)->collect(),
+			sc.parallelize(1L, NUM_VALUES, 7)->filter(odd_f)->mapPartitions(partition_size_f)->collect(),
+			"mapPartitionsWithIndex of filtered") && ok;
+
+	// partitions of a shuffle, some of them may be empty
+	PairRDD<long, long, Pair<long, long> > *reduced = sc.parallelize(1L, NUM_VALUES, 8)
+			->mapToPair(map_to_pair_f)->reduceByKey(reduce_f, 12);
+	reduced->setSticky(true);
+	ok = check(reduced->mapPartitionsWithIndex(partition_index_size_f< Pair<long, long> >)->collect(),
+			reduced->mapPartitions(pair_partition_size_f< Pair<long, long> >)->collect(),
+			"mapPartitionsWithIndex of a shuffle") && ok;
+	delete reduced;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+/*
+ * TestPersist.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "MappedRDD.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+
+long calls = 0; // values computed by double_f on this node
+
+long double_f(long &i) {
+	__sync_fetch_and_add(&calls, 1);
+	return 2 * i;
+}
+
+long sum_f(long &a, long &b) {
+	return a + b;
+}
+
+/*
+ * to run three jobs on a persisted RDD.
+ * all of them see the same values, and only the first one computes them.
+ */
+bool check(SunwayMRContext &sc, StorageLevel level, string name) {
+	MappedRDD<long, long> *rdd = sc.parallelize(1L, NUM_VALUES, 10)->map(double_f);
+	rdd->persist(level);
+
+	long before = calls;
+	long first = rdd->reduce(sum_f);
+	long computed = calls - before;
+	long second = rdd->reduce(sum_f);
+	long n = rdd->count();
+	long recomputed = calls - before - computed;
+
+	bool ok = first == NUM_VALUES * (NUM_VALUES + 1) && second == first
+			&& n == NUM_VALUES && recomputed == 0;
+	cout << name << ": sum " << first << ", " << n << " values, computed "
+			<< computed << " then " << recomputed << " times, "
+			<< (ok ? "passed" : "FAILED") << endl;
+
+	rdd->unpersist();
+	delete rdd;
+	return ok;
+}
+
+/*
+ * deserialized copies of stored partitions are charged to the memory governor.
+ * a task forced to reserve the whole budget, with no other task running,
+ * makes the RDD drop them, and the partitions are still read right afterwards.
+ */
+bool checkCopies(SunwayMRContext &sc, StorageLevel level, string name) {
+	MappedRDD<long, long> *rdd = sc.parallelize(1L, NUM_VALUES, 10)->map(double_f);
+	rdd->persist(level);
+
+	size_t before = XYZ_MEMORY_GOVERNOR.getUsed();
+	long first = rdd->reduce(sum_f);
+	long second = rdd->reduce(sum_f); // deserialized here
+	size_t kept = XYZ_MEMORY_GOVERNOR.getUsed() - before;
+
+	size_t budget = XYZ_MEMORY_GOVERNOR.getBudget();
+	size_t left = before;
+	if (budget > 0) {
+		XYZ_MEMORY_GOVERNOR.reserve(budget, true);
+		left = XYZ_MEMORY_GOVERNOR.getUsed() - budget;
+		XYZ_MEMORY_GOVERNOR.release(budget);
+	}
+	long third = rdd->reduce(sum_f);
+
+	rdd->unpersist();
+	delete rdd;
+	size_t after = XYZ_MEMORY_GOVERNOR.getUsed();
+
+	bool ok = kept > 0 && left == before && after == before && second == first && third == first;
+	cout << name << ": " << kept << " bytes kept, " << left - before << " after spilling, "
+			<< after - before << " after unpersist, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * partitions kept as they are computed are charged to the memory governor by estimate,
+ * and released by unpersist. with the whole budget taken, they are not kept but computed again.
+ */
+bool checkCharged(SunwayMRContext &sc, string name) {
+	MappedRDD<long, long> *rdd = sc.parallelize(1L, NUM_VALUES, 10)->map(double_f);
+	rdd->cache();
+
+	size_t before = XYZ_MEMORY_GOVERNOR.getUsed();
+	long first = rdd->reduce(sum_f);
+	size_t kept = XYZ_MEMORY_GOVERNOR.getUsed() - before;
+	rdd->unpersist();
+	size_t after = XYZ_MEMORY_GOVERNOR.getUsed();
+
+	size_t budget = XYZ_MEMORY_GOVERNOR.getBudget();
+	long recomputed = 0, second = first;
+	if (budget > 0) {
+		rdd->cache();
+		XYZ_MEMORY_GOVERNOR.reserve(budget, true);
+		second = rdd->reduce(sum_f);
+		long start = calls;
+		rdd->reduce(sum_f);
+		recomputed = calls - start;
+		XYZ_MEMORY_GOVERNOR.release(budget);
+		rdd->unpersist();
+	}
+	delete rdd;
+
+	bool ok = kept > 0 && after == before && second == first
+			&& (budget == 0 || recomputed == NUM_VALUES);
+	cout << name << ": " << kept << " bytes kept, " << after - before << " after unpersist, "
+			<< recomputed << " computed again without budget, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestPersist <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestPersist", argc, argv);
+
+	bool ok = check(sc, STORAGE_MEMORY_ONLY, "MEMORY_ONLY");
+	ok = check(sc, STORAGE_MEMORY_ONLY_SER, "MEMORY_ONLY_SER") && ok;
+	ok = check(sc, STORAGE_DISK_ONLY, "DISK_ONLY") && ok;
+	ok = checkCopies(sc, STORAGE_MEMORY_ONLY_SER, "MEMORY_ONLY_SER, copies") && ok;
+	ok = checkCopies(sc, STORAGE_DISK_ONLY, "DISK_ONLY, copies") && ok;
+	ok = checkCharged(sc, "MEMORY_ONLY, charged") && ok;
+
+	return ok ? 0 : 1;
+}
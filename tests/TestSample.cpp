@@ -0,0 +1,95 @@
+/*
+ * TestSample.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <map>
+#include <math.h>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = i % 3;
+	return Pair<long, long>(k, i);
+}
+
+long key_f(Pair<long, long> &p) {
+	return p.v1;
+}
+
+long add_f(long &a, long &b) {
+	return a + b;
+}
+
+/*
+ * to check a sample size within a relative error of the expected size
+ */
+bool check(long count, double expected, double error, string name) {
+	bool ok = fabs(count - expected) <= expected * error;
+	cout << name << ": " << count << " values, " << expected << " expected, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(bool ok, string name) {
+	cout << name << ": " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestSample <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestSample", argc, argv);
+
+	// sizes of samples
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.1, 42)->count(),
+			NUM_VALUES * 0.1, 0.05, "without replacement, 0.1");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.7, 42)->count(),
+			NUM_VALUES * 0.7, 0.05, "without replacement, 0.7") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0, 42)->count(),
+			0, 0, "without replacement, 0") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 1, 42)->count(),
+			NUM_VALUES, 0, "without replacement, 1") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->sample(true, 2.5, 42)->count(),
+			NUM_VALUES * 2.5, 0.02, "with replacement, 2.5") && ok;
+
+	// values are kept at most once without replacement
+	std::map<long, long> times = sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.5, 42)->countByValue();
+	bool once = true;
+	for (std::map<long, long>::iterator it = times.begin(); it != times.end(); ++it) {
+		if (it->second != 1 || it->first < 1 || it->first > NUM_VALUES) once = false;
+	}
+	ok = check(once, "without replacement, values kept once") && ok;
+
+	// the same seed gives the same sample
+	long sum1 = sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.1, 42)->reduce(add_f);
+	long sum2 = sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.1, 42)->reduce(add_f);
+	long sum3 = sc.parallelize(1L, NUM_VALUES, 16)->sample(false, 0.1, 43)->reduce(add_f);
+	ok = check(sum1 == sum2 && sum1 != sum3, "samples by seeds") && ok;
+
+	// fraction of each key
+	std::map<long, double> fractions;
+	fractions[0] = 0.5;
+	fractions[1] = 0.05;
+	std::map<long, long> keys = sc.parallelize(1L, NUM_VALUES, 16)
+			->mapToPair(map_to_pair_f)
+			->sampleByKey(false, fractions, 7)
+			->map(key_f)
+			->countByValue();
+	ok = check(keys[0], NUM_VALUES / 3 * 0.5, 0.05, "sampleByKey, key 0") && ok;
+	ok = check(keys[1], NUM_VALUES / 3 * 0.05, 0.15, "sampleByKey, key 1") && ok;
+	ok = check(keys[2], 0, 0, "sampleByKey, key 2") && ok;
+
+	return ok ? 0 : 1;
+}
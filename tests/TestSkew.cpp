@@ -0,0 +1,136 @@
+/*
+ * TestSkew.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "HashDivider.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 1000000;
+const long NUM_JOIN_VALUES = 300000;
+const long NUM_SMALL_VALUES = 2000;
+const int NUM_PARTITIONS = 8;
+
+/*
+ * whether a key falls in partition 0 of the shuffles below
+ */
+bool in_first_partition(long k) {
+	long one = 1;
+	Pair<long, long> p(k, one);
+	HashDivider hd(NUM_PARTITIONS);
+	return hd.getPartition(xyz_pair_rdd_combine_by_key_inner_hash_f<long, long>(p)) == 0;
+}
+
+/*
+ * keys of partition 0 are all distinct, so it stays large after map-side combine,
+ * other partitions share 64 keys
+ */
+long wide_key(long i) {
+	return in_first_partition(i) ? i : i % 64;
+}
+
+Pair<long, long> wide_f(long &i) {
+	long k = wide_key(i), one = 1;
+	return Pair<long, long>(k, one);
+}
+
+/*
+ * three of four values have the hot key 0, the others have distinct keys
+ */
+Pair<long, long> hot_f(long &i) {
+	long k = i % 4 == 0 ? i : 0;
+	return Pair<long, long>(k, i);
+}
+
+/*
+ * keys 0 to 999, two values each
+ */
+Pair<long, long> small_f(long &i) {
+	long k = i % 1000;
+	return Pair<long, long>(k, i);
+}
+
+Pair<long, long> add_f(Pair<long, long> &a, Pair<long, long> &b) {
+	long sum = a.v2 + b.v2;
+	return Pair<long, long>(a.v1, sum);
+}
+
+/*
+ * to compare pairs in any order
+ */
+template <class T>
+bool check(vector<T> result, vector<T> expected, string name) {
+	sort(result.begin(), result.end());
+	sort(expected.begin(), expected.end());
+	bool ok = result.size() > 0 && result == expected;
+	cout << name << ": " << result.size() << " pairs, " << expected.size() << " expected, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(bool ok, string name) {
+	cout << name << ": " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestSkew <hosts file> <master> <listen port>
+ * skew handling runs with default settings.
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestSkew", argc, argv);
+
+	// a partition with far more distinct keys than the others is combined by slices
+	map<long, long> counts;
+	for(long i = 1; i <= NUM_VALUES; i++) {
+		counts[wide_key(i)]++;
+	}
+	vector< Pair<long, long> > expected;
+	for(map<long, long>::iterator it = counts.begin(); it != counts.end(); ++it) {
+		long k = it->first;
+		expected.push_back(Pair<long, long>(k, it->second));
+	}
+	PairRDD<long, long, Pair<long, long> > *reduced = sc.parallelize(1L, NUM_VALUES, 8)
+			->mapToPair(wide_f)->reduceByKey(add_f, NUM_PARTITIONS);
+	bool ok = check(reduced->collect(), expected, "reduceByKey of a skewed partition");
+	delete reduced;
+
+	// a hot key on the left side of a join, whose right values are replicated to every slice
+	PairRDD<long, long, long> *hot = sc.parallelize(1L, NUM_JOIN_VALUES, 8)->mapToPair(hot_f);
+	PairRDD<long, long, long> *small = sc.parallelize(1L, NUM_SMALL_VALUES, 4)->mapToPair(small_f);
+	hot->setSticky(true);
+	small->setSticky(true);
+
+	PairRDD< long, Pair<long, long>, Pair< long, Pair<long, long> > > *joined = hot->join(small, NUM_PARTITIONS);
+	vector< Pair< long, Pair<long, long> > > result = joined->collect(); // partitions are split by shuffle
+	ok = check((int)joined->getPartitions().size() > NUM_PARTITIONS, "skewed partition of join split") && ok;
+	ok = check(result, hot->broadcastJoin(small)->collect(), "join with a hot key") && ok;
+	delete joined;
+
+	// the hot key on the right side
+	PairRDD< long, Pair<long, long>, Pair< long, Pair<long, long> > > *joined2 = small->join(hot, NUM_PARTITIONS);
+	result = joined2->collect();
+	ok = check((int)joined2->getPartitions().size() > NUM_PARTITIONS, "skewed partition of join split, the other side") && ok;
+	ok = check(result, small->broadcastJoin(hot)->collect(), "join with a hot key, the other side") && ok;
+	delete joined2;
+
+	// groups are never split
+	ok = check(hot->groupByKey(NUM_PARTITIONS)->count() == NUM_JOIN_VALUES / 4 + 1, "groupByKey of a hot key") && ok;
+
+	delete hot;
+	delete small;
+
+	return ok ? 0 : 1;
+}
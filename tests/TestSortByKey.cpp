@@ -0,0 +1,103 @@
+/*
+ * TestSortByKey.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 10000;
+const int NUM_PARTITIONS = 4;
+
+/*
+ * scatter keys over [0, 1000)
+ */
+Pair<long, long> map_to_pair_f(long &i) {
+	long k = (i * 7919) % 1000;
+	return Pair<long, long>(k, i);
+}
+
+/*
+ * to describe a partition of ascending keys by 4 values:
+ * whether it is sorted, number of pairs, first key and last key.
+ */
+void ascending_partition_f(int index, IteratorSeq< Pair<long, long> > &it, vector<long> &ret) {
+	bool sorted = true;
+	for (size_t i = 1; i < it.size(); i++) {
+		if (it.at(i).v1 < it.at(i - 1).v1) sorted = false;
+	}
+	ret.push_back(sorted ? 1 : 0);
+	ret.push_back(it.size());
+	ret.push_back(it.size() > 0 ? it.at(0).v1 : -1);
+	ret.push_back(it.size() > 0 ? it.at(it.size() - 1).v1 : -1);
+}
+
+/*
+ * the same for descending keys
+ */
+void descending_partition_f(int index, IteratorSeq< Pair<long, long> > &it, vector<long> &ret) {
+	bool sorted = true;
+	for (size_t i = 1; i < it.size(); i++) {
+		if (it.at(i - 1).v1 < it.at(i).v1) sorted = false;
+	}
+	ret.push_back(sorted ? 1 : 0);
+	ret.push_back(it.size());
+	ret.push_back(it.size() > 0 ? it.at(0).v1 : -1);
+	ret.push_back(it.size() > 0 ? it.at(it.size() - 1).v1 : -1);
+}
+
+/*
+ * to check descriptions of all partitions in order:
+ * every partition is sorted, all pairs are kept,
+ * and keys of a partition all come before keys of the next one.
+ * the same key never spans two partitions.
+ */
+bool check(vector<long> &parts, bool ascending, string name) {
+	bool ok = (int)parts.size() == 4 * NUM_PARTITIONS;
+	long total = 0;
+	long last = -1;
+	for (size_t i = 0; ok && i < parts.size(); i += 4) {
+		if (parts[i] != 1) ok = false;
+		total += parts[i + 1];
+		if (parts[i + 1] == 0) continue;
+		if (last >= 0 && (ascending ? parts[i + 2] <= last : parts[i + 2] >= last)) ok = false;
+		last = parts[i + 3];
+	}
+	if (total != NUM_VALUES) ok = false;
+
+	cout << name << ": " << total << " pairs in " << parts.size() / 4 << " partitions, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestSortByKey <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestSortByKey", argc, argv);
+
+	vector<long> asc = sc.parallelize(1L, NUM_VALUES, 10)
+			->mapToPair(map_to_pair_f)
+			->sortByKey(true, NUM_PARTITIONS)
+			->mapPartitionsWithIndex(ascending_partition_f)
+			->collect();
+	bool ok = check(asc, true, "ascending");
+
+	vector<long> desc = sc.parallelize(1L, NUM_VALUES, 10)
+			->mapToPair(map_to_pair_f)
+			->sortByKey(false, NUM_PARTITIONS)
+			->mapPartitionsWithIndex(descending_partition_f)
+			->collect();
+	ok = check(desc, false, "descending") && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+/*
+ * TestTake.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+const long NUM_PARTITIONS = 8;
+
+/*
+ * values of the last partition only, so take scans more partitions each time
+ */
+bool last_partition_f(long &i) {
+	return i > NUM_VALUES - NUM_VALUES / NUM_PARTITIONS;
+}
+
+/*
+ * to compare values with first, first + 1, ... of count values
+ */
+bool check(vector<long> values, long first, long count, string name) {
+	bool ok = (long)values.size() == count;
+	for (long i = 0; ok && i < count; i++) {
+		ok = values[i] == first + i;
+	}
+	cout << name << ": " << values.size() << " values, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(long result, long expected, string name) {
+	bool ok = result == expected;
+	cout << name << ": " << result << ", " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestTake <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestTake", argc, argv);
+
+	long partition = NUM_VALUES / NUM_PARTITIONS;
+	long last = NUM_VALUES - partition + 1;
+
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->take(0), 1, 0, "take 0");
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->take(5), 1, 5,
+			"take less than the first partition") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->take(partition * 3 + 7), 1, partition * 3 + 7,
+			"take of several partitions") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->take(NUM_VALUES + 10), 1, NUM_VALUES,
+			"take more than all") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->filter(last_partition_f)->take(10), last, 10,
+			"take of the last partition") && ok;
+
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->first(), 1, "first") && ok;
+	ok = check(sc.parallelize(1L, NUM_VALUES, NUM_PARTITIONS)->filter(last_partition_f)->first(), last,
+			"first of the last partition") && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/*
+ * TestTop.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "MappedRDD.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 100000;
+
+/*
+ * scatter values, without repeating any
+ */
+long scatter_f(long &i) {
+	return (i * 7919) % 100003;
+}
+
+/*
+ * to order values by the last digit first
+ */
+bool last_digit_less_f(long &a, long &b) {
+	return a % 10 < b % 10 || (a % 10 == b % 10 && a < b);
+}
+
+bool last_digit_greater_f(long a, long b) {
+	return last_digit_less_f(b, a);
+}
+
+/*
+ * to compare the result with the first k values of expected
+ */
+bool check(vector<long> result, vector<long> &expected, long k, string name) {
+	if (k > (long)expected.size()) k = expected.size();
+	bool ok = result == vector<long>(expected.begin(), expected.begin() + k);
+	cout << name << ": " << result.size() << " values, " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestTop <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestTop", argc, argv);
+
+	vector<long> ascending, descending, small;
+	for (long i = 1; i <= NUM_VALUES; i++) {
+		ascending.push_back(scatter_f(i));
+	}
+	sort(ascending.begin(), ascending.end());
+	descending = vector<long>(ascending.rbegin(), ascending.rend());
+
+	bool ok = check(sc.parallelize(1L, NUM_VALUES, 16)->map(scatter_f)->top(5),
+			descending, 5, "top");
+	ok = check(sc.parallelize(1L, NUM_VALUES, 16)->map(scatter_f)->takeOrdered(5),
+			ascending, 5, "takeOrdered") && ok;
+
+	for (long i = 1; i <= 1000; i++) {
+		small.push_back(i);
+	}
+	sort(small.begin(), small.end(), last_digit_greater_f);
+	ok = check(sc.parallelize(1L, 1000L, 7)->top(4, last_digit_less_f),
+			small, 4, "top by last digit") && ok;
+	reverse(small.begin(), small.end());
+	ok = check(sc.parallelize(1L, 1000L, 7)->takeOrdered(4, last_digit_less_f),
+			small, 4, "takeOrdered by last digit") && ok;
+
+	vector<long> ten;
+	for (long i = 10; i >= 1; i--) {
+		ten.push_back(i);
+	}
+	ok = check(sc.parallelize(1L, 10L, 4)->top(100), ten, 100, "top of more than all") && ok;
+	ok = check(sc.parallelize(1L, 10L, 4)->top(0), ten, 0, "top of none") && ok;
+
+	return ok ? 0 : 1;
+}
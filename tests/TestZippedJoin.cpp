@@ -0,0 +1,115 @@
+/*
+ * TestZippedJoin.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+#include "SunwayMRContext.hpp"
+#include "ParallelArrayRDD.hpp"
+#include "PairRDD.hpp"
+#include "Pair.hpp"
+#include "Logging.hpp"
+using namespace std;
+
+const long NUM_VALUES = 20000;
+const int NUM_PARTITIONS = 6;
+
+/*
+ * keys 0 to 99
+ */
+Pair<long, long> left_f(long &i) {
+	long k = i % 100;
+	return Pair<long, long>(k, i);
+}
+
+/*
+ * keys 50 to 149, keys 0 to 49 are only on the left, 100 to 149 only here
+ */
+Pair<long, long> right_f(long &i) {
+	long k = 50 + i % 100;
+	long one = 1;
+	return Pair<long, long>(k, one);
+}
+
+Pair<long, long> add_f(Pair<long, long> &a, Pair<long, long> &b) {
+	long sum = a.v2 + b.v2;
+	return Pair<long, long>(a.v1, sum);
+}
+
+long negate_f(long &v) {
+	return -v;
+}
+
+Pair<long, long> negate_pair_f(Pair<long, long> &p) {
+	long v = -p.v2;
+	return Pair<long, long>(p.v1, v);
+}
+
+/*
+ * to compare joined pairs in any order
+ */
+bool check(vector< Pair< long, Pair<long, long> > > result,
+		vector< Pair< long, Pair<long, long> > > expected, string name) {
+	sort(result.begin(), result.end());
+	sort(expected.begin(), expected.end());
+	bool ok = result.size() > 0 && result == expected;
+	cout << name << ": " << result.size() << " pairs, " << expected.size() << " expected, "
+			<< (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+bool check(bool ok, string name) {
+	cout << name << ": " << (ok ? "passed" : "FAILED") << endl;
+	return ok;
+}
+
+/*
+ * usage: TestZippedJoin <hosts file> <master> <listen port>
+ */
+int main(int argc, char *argv[])
+{
+	SunwayMRContext sc("TestZippedJoin", argc, argv);
+
+	// co-partitioned by shuffles of the same number of partitions
+	PairRDD<long, long, Pair<long, long> > *left = sc.parallelize(1L, NUM_VALUES, 8)
+			->mapToPair(left_f)->reduceByKey(add_f, NUM_PARTITIONS);
+	PairRDD<long, long, Pair<long, long> > *right = sc.parallelize(1L, NUM_VALUES, 5)
+			->mapToPair(right_f)->reduceByKey(add_f, NUM_PARTITIONS);
+	left->setSticky(true);
+	right->setSticky(true);
+
+	HashDivider *lp = left->getPartitioner(), *rp = right->getPartitioner();
+	bool ok = check(lp != NULL && rp != NULL && lp->equals(*rp), "co-partitioned");
+	ok = check(left->join(right)->getPartitioner() != NULL, "join zipped, partitioner kept") && ok;
+
+	// a join of another number of partitions shuffles both sides
+	ok = check(left->join(right)->collect(), left->join(right, NUM_PARTITIONS + 1)->collect(),
+			"zipped join and shuffle join") && ok;
+	ok = check(right->join(left)->collect(), right->join(left, NUM_PARTITIONS - 1)->collect(),
+			"zipped join and shuffle join, the other side") && ok;
+
+	// mapValues with a function of values keeps the partitioner
+	PairRDD<long, long, Pair<long, long> > *negated = left->mapValues(negate_f);
+	negated->setSticky(true);
+	ok = check(negated->join(right)->getPartitioner() != NULL, "join after mapValues zipped") && ok;
+	ok = check(negated->join(right)->collect(), negated->join(right, NUM_PARTITIONS + 1)->collect(),
+			"zipped join and shuffle join after mapValues") && ok;
+
+	// a function of pairs may change keys, so the partitioner is dropped, but results are the same
+	PairRDD<long, long, Pair<long, long> > *negatedPairs = left->mapValues(negate_pair_f);
+	negatedPairs->setSticky(true);
+	ok = check(negatedPairs->getPartitioner() == NULL, "mapValues of pairs drops the partitioner") && ok;
+	ok = check(negatedPairs->join(right)->collect(), negated->join(right)->collect(),
+			"join after mapValues of pairs") && ok;
+
+	delete negatedPairs;
+	delete negated;
+	delete left;
+	delete right;
+
+	return ok ? 0 : 1;
+}